@@ -9,6 +9,8 @@
 #include <chrono>
 #include <Sort.h>
 #include <iostream>
+#include <string>
+#include <vector>
 
 using Real = opensmt::Real;
 
@@ -128,4 +130,99 @@ BENCHMARK_F(RationalEfficiencyFixture, smallSubtraction)(benchmark::State& st) {
         den = std::max<int>(1, (den + 1) % INT32_MAX);
         benchmark::DoNotOptimize(c);
     }
-}
\ No newline at end of file
+}
+// Values that do not fit 32 bits but fit 64 bits, such as timestamps in milliseconds (about 2^40) and fractions with
+// such numerators.  The counter `spills` reports how many values per iteration needed the mpq representation.
+class WideRationalFixture : public ::benchmark::Fixture {
+protected:
+    static constexpr std::size_t count = 1024;
+    std::vector<Real> stamps;      // Integers from 1650000000000 on
+    std::vector<Real> fractions;   // The integers divided by 1024
+    std::size_t index = 0;
+    uint64_t startSpills = 0;
+
+    Real const & stamp() const { return stamps[index]; }
+    Real const & nextStamp() const { return stamps[(index + 1) % count]; }
+    void advance() { index = (index + 1) % count; }
+
+public:
+    void SetUp(const ::benchmark::State&) {
+        stamps.clear();
+        fractions.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string value = std::to_string(1650000000000 + 7 * i);
+            stamps.emplace_back(value.c_str());
+            fractions.emplace_back((value + "/1024").c_str());
+        }
+        startSpills = FastRational::getMpqPoolStatistics().spills;
+    }
+
+    void TearDown(::benchmark::State& st) {
+        uint64_t spills = FastRational::getMpqPoolStatistics().spills - startSpills;
+        st.counters["spills"] = benchmark::Counter(static_cast<double>(spills), benchmark::Counter::kAvgIterations);
+    }
+};
+
+BENCHMARK_F(WideRationalFixture, wideSum)(benchmark::State& st) {
+    Real c;
+    for (auto _ : st) {
+        c = stamp() + nextStamp();
+        advance();
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+BENCHMARK_F(WideRationalFixture, wideSubtraction)(benchmark::State& st) {
+    Real c;
+    for (auto _ : st) {
+        c = nextStamp() - stamp();
+        advance();
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+BENCHMARK_F(WideRationalFixture, wideMulSmall)(benchmark::State& st) {
+    Real c;
+    Real factor(3, 7);
+    for (auto _ : st) {
+        c = stamp() * factor;
+        advance();
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+BENCHMARK_F(WideRationalFixture, wideFractionSum)(benchmark::State& st) {
+    Real c;
+    Real third(1, 3);
+    for (auto _ : st) {
+        c = fractions[index] + third;
+        advance();
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+BENCHMARK_F(WideRationalFixture, wideAdditionAssign)(benchmark::State& st) {
+    Real c = stamp();
+    Real step(1, 1000);
+    for (auto _ : st) {
+        c += step;
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+BENCHMARK_F(WideRationalFixture, wideCompare)(benchmark::State& st) {
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(fractions[index] < nextStamp());
+        advance();
+    }
+}
+
+// The products exceed 64 bits, so both representations need mpq here
+BENCHMARK_F(WideRationalFixture, wideMulOverflow)(benchmark::State& st) {
+    Real c;
+    for (auto _ : st) {
+        c = stamp() * nextStamp();
+        advance();
+        benchmark::DoNotOptimize(c);
+    }
+}
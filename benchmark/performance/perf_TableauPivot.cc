@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <lasolver/Tableau.h>
+
+#include <random>
+
+using Real = opensmt::Real;
+
+/*
+ * Pivot throughput on generated tableaux.  The arguments are the number of rows, the number of terms in a row, and the
+ * kind of the coefficients: 0 for +-1, 1 for small fractions, 2 for fractions that do not fit into a machine word.
+ * The number of non-basic variables is twice the number of rows.  Only the pivots are timed; a fresh tableau is built
+ * for every batch of pivots so that the rows do not fill up over the run.
+ */
+class TableauPivotFixture : public ::benchmark::Fixture {
+protected:
+    static constexpr int pivotsPerTableau = 50;
+
+    std::mt19937 rng{42};
+    Tableau tableau;
+    std::vector<LVRef> basicVars;
+
+    Real coefficient(int kind) {
+        std::uniform_int_distribution<int> small(1, 9);
+        int sign = rng() % 2 == 0 ? 1 : -1;
+        switch (kind) {
+            case 0:
+                return sign;
+            case 1:
+                return Real(sign * small(rng), small(rng));
+            default:
+                return Real(sign * small(rng), small(rng)) * Real("12345678901234567890") / Real("9876543210987654321");
+        }
+    }
+
+    void buildTableau(int rows, int termsPerRow, int kind) {
+        tableau.clear();
+        basicVars.clear();
+        uint32_t const nonBasic = 2 * rows;
+        for (uint32_t i = 0; i < nonBasic; ++i) {
+            tableau.newNonbasicVar(LVRef{i});
+        }
+        std::uniform_int_distribution<uint32_t> var(0, nonBasic - 1);
+        for (int r = 0; r < rows; ++r) {
+            LVRef basic {nonBasic + r};
+            auto poly = std::make_unique<Tableau::Polynomial>();
+            while (poly->size() < static_cast<std::size_t>(termsPerRow)) {
+                LVRef v {var(rng)};
+                if (not poly->contains(v)) {
+                    poly->addTerm(v, coefficient(kind));
+                }
+            }
+            tableau.newRow(basic, std::move(poly));
+            tableau.quasiToBasic(basic);
+            basicVars.push_back(basic);
+        }
+    }
+
+    void randomPivot() {
+        std::size_t index = rng() % basicVars.size();
+        LVRef bv = basicVars[index];
+        auto const & row = tableau.getRowPoly(bv);
+        auto it = row.begin();
+        for (std::size_t skip = rng() % row.size(); skip > 0; --skip) { ++it; }
+        LVRef nv = it->var;
+        tableau.pivot(bv, nv);
+        basicVars[index] = nv;
+    }
+};
+
+BENCHMARK_DEFINE_F(TableauPivotFixture, Pivot)(benchmark::State& st) {
+    int const rows = static_cast<int>(st.range(0));
+    int const termsPerRow = static_cast<int>(st.range(1));
+    int const kind = static_cast<int>(st.range(2));
+    std::size_t pivots = 0;
+    for (auto _ : st) {
+        st.PauseTiming();
+        buildTableau(rows, termsPerRow, kind);
+        st.ResumeTiming();
+        for (int i = 0; i < pivotsPerTableau; ++i) {
+            randomPivot();
+        }
+        pivots += pivotsPerTableau;
+    }
+    st.counters["pivots"] = benchmark::Counter(static_cast<double>(pivots), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(TableauPivotFixture, Pivot)
+    ->ArgNames({"rows", "terms", "kind"})
+    ->Args({100, 3, 0})
+    ->Args({100, 3, 1})
+    ->Args({100, 3, 2})
+    ->Args({1000, 5, 0})
+    ->Args({1000, 5, 1})
+    ->Args({1000, 5, 2})
+    ->Args({1000, 20, 1})
+    ->Unit(benchmark::kMicrosecond);
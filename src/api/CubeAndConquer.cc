@@ -0,0 +1,124 @@
+#include "CubeAndConquer.h"
+#include "MainSplitter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+CubeAndConquer::CubeAndConquer(Logic & logic, SMTConfig & config, std::string const & name, unsigned int numberOfWorkers)
+    : logic(logic)
+{
+    if (numberOfWorkers == 0) { throw OsmtApiException("Cube and conquer needs at least one worker"); }
+    config.setUsedForInitiliazation();
+    for (unsigned int i = 0; i < numberOfWorkers; i++) {
+        workers.push_back(std::make_unique<ParallelWorker>(logic, ParallelWorker::createConfig(config), name + "-" + std::to_string(i)));
+    }
+}
+
+CubeAndConquer::~CubeAndConquer() = default;
+
+void CubeAndConquer::popSatisfiableCube() {
+    if (winner >= 0) {
+        workers[winner]->getSolver().pop();
+        winner = -1;
+    }
+}
+
+void CubeAndConquer::insertFormula(PTRef fla) {
+    if (logic.getSortRef(fla) != logic.getSort_bool()) {
+        throw OsmtApiException(std::string("Top-level assertion sort must be ") + Logic::s_sort_bool + ", got " + logic.printSort(logic.getSortRef(fla)));
+    }
+    popSatisfiableCube();
+    symbols.collect(logic, fla);
+    for (auto & worker : workers) {
+        worker->getSolver().insertFormula(worker->translate(fla));
+    }
+}
+
+sstat CubeAndConquer::solve(MainSplitter const & splitter) {
+    return solve(splitter.getSplitFormulas());
+}
+
+sstat CubeAndConquer::solve(std::vector<PTRef> const & cubes) {
+    popSatisfiableCube();
+    satisfiableCube = -1;
+    cubeResults.assign(cubes.size(), s_Undef);
+
+    // Translation uses the user's logic, so it cannot be done in the worker threads
+    std::vector<std::vector<PTRef>> workerCubes(workers.size());
+    for (PTRef cube : cubes) {
+        symbols.collect(logic, cube);
+        for (unsigned int w = 0; w < workers.size(); w++) {
+            workerCubes[w].push_back(workers[w]->translate(cube));
+        }
+    }
+    for (auto & worker : workers) {
+        worker->getSolver().getSMTSolver().stop = false;
+    }
+
+    std::atomic<std::size_t> nextCube{0};
+    std::atomic<int> decided{-1};
+    std::vector<std::exception_ptr> errors(workers.size());
+
+    auto run = [&](unsigned int w) {
+        MainSolver & solver = workers[w]->getSolver();
+        try {
+            while (decided.load() < 0) {
+                std::size_t i = nextCube++;
+                if (i >= cubes.size()) { return; }
+                solver.push();
+                solver.insertFormula(workerCubes[w][i]);
+                sstat res = solver.check();
+                cubeResults[i] = res;
+                int none = -1;
+                if (res == s_True and decided.compare_exchange_strong(none, static_cast<int>(w))) {
+                    // The winner keeps the cube asserted, so that the model can be queried
+                    satisfiableCube = static_cast<int>(i);
+                    for (unsigned int j = 0; j < workers.size(); j++) {
+                        if (j != w) { workers[j]->getSolver().stop(); }
+                    }
+                    return;
+                }
+                solver.pop();
+                if (res != s_False) { return; }
+            }
+        } catch (...) {
+            errors[w] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers.size());
+    for (unsigned int w = 0; w < workers.size(); w++) {
+        threads.emplace_back(run, w);
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    winner = decided.load();
+    if (winner >= 0) {
+        status = s_True;
+    } else if (std::all_of(cubeResults.begin(), cubeResults.end(), [](sstat res) { return res == s_False; })) {
+        status = s_False;
+    } else {
+        for (auto const & error : errors) {
+            if (error) { std::rethrow_exception(error); }
+        }
+        status = s_Undef;
+    }
+    return status;
+}
+
+void CubeAndConquer::stop() {
+    for (auto & worker : workers) {
+        worker->getSolver().stop();
+    }
+}
+
+std::unique_ptr<Model> CubeAndConquer::getModel() {
+    if (status != s_True) { throw OsmtApiException("Model cannot be created if solver is not in SAT state"); }
+    assert(winner >= 0);
+    return workers[winner]->getModel(symbols);
+}
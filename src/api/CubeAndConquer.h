@@ -0,0 +1,47 @@
+#ifndef OPENSMT_CUBEANDCONQUER_H
+#define OPENSMT_CUBEANDCONQUER_H
+
+#include "ParallelWorker.h"
+
+#include <memory>
+#include <vector>
+
+class MainSplitter;
+
+/**
+ * Solves the partitions of an instance in parallel threads.
+ *
+ * The partitions are typically the splits produced by MainSplitter (scatter or lookahead splitting).  Each worker
+ * solves the instance under one partition at a time; the partition is asserted in its own push frame, so the
+ * clauses learnt from the instance are kept in the worker when it moves on to the next partition.  The instance is
+ * satisfiable as soon as one partition is, and unsatisfiable once all partitions are.  The partitions are expected
+ * to cover the search space of the instance, as the splits of MainSplitter do.
+ */
+class CubeAndConquer {
+    Logic & logic;
+    std::vector<std::unique_ptr<ParallelWorker>> workers;
+    ParallelWorker::UserSymbols symbols; // Symbols appearing in the inserted formulas and the cubes
+    std::vector<sstat> cubeResults;
+    sstat status = s_Undef;
+    int winner = -1;                     // The worker that found a satisfiable cube; it keeps the cube until the next call
+    int satisfiableCube = -1;
+
+    void popSatisfiableCube();
+
+public:
+    CubeAndConquer(Logic & logic, SMTConfig & config, std::string const & name, unsigned int numberOfWorkers);
+    ~CubeAndConquer();
+
+    void insertFormula(PTRef fla); // Adds a formula of the instance, shared by all cubes
+    sstat solve(std::vector<PTRef> const & cubes);
+    sstat solve(MainSplitter const & splitter);
+    void stop();
+
+    sstat getStatus() const { return status; }
+    std::vector<sstat> const & getCubeResults() const { return cubeResults; } // Result of each cube, s_Undef if not solved
+    int getSatisfiableCube() const { return satisfiableCube; }                // -1 if no cube was found satisfiable
+    std::unique_ptr<Model> getModel();
+    unsigned int getNumberOfWorkers() const { return workers.size(); }
+};
+
+#endif //OPENSMT_CUBEANDCONQUER_H
@@ -32,6 +32,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Model.h"
 #include "PartitionManager.h"
 #include "InterpolationContext.h"
+#include "FastRational.h"
 
 #include <memory>
 
@@ -97,6 +98,8 @@ class MainSolver
     };
 
 
+    // Declared first so that it is destroyed last: returns the mpq storage pooled by the destroying thread to the heap
+    struct RationalPoolTrimmer { ~RationalPoolTrimmer() { FastRational::trimMpqPool(); } } rationalPoolTrimmer;
     std::unique_ptr<Theory>         theory;
     std::unique_ptr<TermMapper>     term_mapper;
     std::unique_ptr<THandler>       thandler;
@@ -11,38 +11,43 @@
 #include "ScatterSplitter.h"
 #include <cmath>
 
-void MainSplitter::writeSplits(std::string const & baseName) const {
-    assert(config.sat_split_type() != spt_none);
-    assert(strcmp(config.output_dir(),"") != 0);
-
-    std::vector<SplitData> const & splits = (config.sat_split_type() == spt_scatter)
+std::vector<SplitData> const & MainSplitter::getSplits() const {
+    return (config.sat_split_type() == spt_scatter)
             ? dynamic_cast<ScatterSplitter&>(ts.solver).getSplits()
             : dynamic_cast<LookaheadSplitter&>(ts.solver).getSplits();
+}
 
-    int i = 0;
-
-    auto addToConjunction = [this](std::vector<vec<PtAsgn>> const & in, vec<PTRef> & out) {
-        for (const auto & constr : in) {
-            vec<PTRef> disj_vec;
-            for (PtAsgn pta : constr)
-                disj_vec.push(pta.sgn == l_True ? pta.tr : logic.mkNot(pta.tr));
-            out.push(logic.mkOr(std::move(disj_vec)));
+std::vector<PTRef> MainSplitter::getSplitFormulas() const {
+    assert(config.sat_split_type() != spt_none);
+    std::vector<PTRef> formulas;
+    for (auto const & split : getSplits()) {
+        vec<PTRef> clauses;
+        for (auto const & constraint : split.constraintsToPTRefs(*thandler)) {
+            vec<PTRef> clause;
+            for (PtAsgn pta : constraint) {
+                clause.push(pta.sgn == l_True ? pta.tr : logic.mkNot(pta.tr));
+            }
+            clauses.push(logic.mkOr(std::move(clause)));
         }
-    };
-
-    for (auto const &split : splits) {
-        vec<PTRef> conj_vec;
+        formulas.push_back(logic.mkAnd(std::move(clauses)));
+    }
+    return formulas;
+}
 
-        addToConjunction(split.constraintsToPTRefs(*thandler), conj_vec);
+void MainSplitter::writeSplits(std::string const & baseName) const {
+    assert(config.sat_split_type() != spt_none);
+    assert(strcmp(config.output_dir(),"") != 0);
 
-        PTRef problem = logic.mkAnd(conj_vec);
+    std::vector<PTRef> problems = getSplitFormulas();
 
-        auto zeroPadNumber = [](int number, unsigned long targetLength) {
-            std::string s = std::to_string(number);
-            return std::string(targetLength - std::min(targetLength, s.length()), '0') + s;
-        };
+    auto zeroPadNumber = [](int number, unsigned long targetLength) {
+        std::string s = std::to_string(number);
+        return std::string(targetLength - std::min(targetLength, s.length()), '0') + s;
+    };
 
-        std::string name = baseName + '-' + zeroPadNumber(i++, static_cast<int>(std::log10(splits.size()))+1) + ".smt2";
+    int i = 0;
+    for (PTRef problem : problems) {
+        std::string name = baseName + '-' + zeroPadNumber(i++, static_cast<int>(std::log10(problems.size()))+1) + ".smt2";
         std::ofstream outFile;
         outFile.open(name);
         if (outFile.is_open()) {
@@ -62,27 +67,10 @@ std::unique_ptr<SimpSMTSolver> MainSplitter::createInnerSolver(SMTConfig & confi
     }
 }
 
-std::vector<std::string> MainSplitter::getPartitionClauses() {
+std::vector<std::string> MainSplitter::getPartitionClauses() const {
     std::vector<std::string> partitions;
-    std::vector<SplitData> const &splits = (config.sat_split_type() == spt_scatter)
-                                           ? dynamic_cast<ScatterSplitter &>(ts.solver).getSplits()
-                                           : dynamic_cast<LookaheadSplitter &>(ts.solver).getSplits();
-    for (auto const &split : splits) {
-        std::vector<vec<PtAsgn>> constraints;
-        split.constraintsToPTRefs(*thandler);
-        vec<PTRef> clauses;
-        for (auto const &constraint : constraints) {
-            vec<PTRef> clause;
-            for (auto const &ptAsgn : constraint) {
-                PTRef pt =
-                        ptAsgn.sgn == l_True ?
-                        ptAsgn.tr :
-                        logic.mkNot(ptAsgn.tr);
-                clause.push(pt);
-            }
-            clauses.push(logic.mkOr(clause));
-        }
-        partitions.push_back(logic.dumpWithLets(logic.mkAnd(clauses)));
+    for (PTRef problem : getSplitFormulas()) {
+        partitions.push_back(logic.dumpWithLets(problem));
     }
     return partitions;
-}
\ No newline at end of file
+}
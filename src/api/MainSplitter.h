@@ -9,6 +9,7 @@
 #define OPENSMT_MAINSPLITTER_H
 
 #include "MainSolver.h"
+#include "SplitData.h"
 
 class MainSplitter : public MainSolver {
 
@@ -21,7 +22,9 @@ public:
                  MainSolver(std::move(t), std::move(tm), std::move(th), std::move(ss),logic,config, std::move(name))
                  {}
 
-    std::vector<std::string> getPartitionClauses();
+    std::vector<SplitData> const & getSplits() const;
+    std::vector<PTRef> getSplitFormulas() const; // Each split as a conjunction of clauses, in the order of getSplits()
+    std::vector<std::string> getPartitionClauses() const;
     void writeSplits(std::string const & file) const;
 };
 
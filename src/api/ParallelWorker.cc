@@ -0,0 +1,59 @@
+#include "ParallelWorker.h"
+
+#include "LogicFactory.h"
+#include "TreeOps.h"
+
+void ParallelWorker::UserSymbols::collect(Logic const & logic, PTRef fla) {
+    auto isVarOrUF = [&logic](PTRef tr) { return logic.isVar(tr) or logic.isUF(tr); };
+    for (PTRef tr : matchingSubTerms(logic, fla, isVarOrUF)) {
+        if (logic.isVar(tr)) {
+            variables.insert(tr);
+        } else {
+            functions.insert(logic.getSymRef(tr));
+        }
+    }
+}
+
+// The worker is expected to be created in the thread that owns userLogic, as the logics are not constructed concurrently
+ParallelWorker::ParallelWorker(Logic & userLogic, std::unique_ptr<SMTConfig> config_, std::string const & name)
+    : userLogic(userLogic)
+    , logic(opensmt::LogicFactory::getInstance(userLogic.getLogic()))
+    , config(std::move(config_))
+    , solver(std::make_unique<MainSolver>(*logic, *config, name))
+    , toWorker(userLogic, *logic)
+{}
+
+std::unique_ptr<SMTConfig> ParallelWorker::createConfig(SMTConfig const & base) {
+    auto workerConfig = std::make_unique<SMTConfig>();
+    workerConfig->copyOptionsFrom(base);
+
+    const char* msg;
+    workerConfig->setOption(SMTConfig::o_produce_stats, SMTOption(0), msg);
+    workerConfig->setOption(SMTConfig::o_sat_scatter_split, SMTOption(0), msg);
+    workerConfig->setOption(SMTConfig::o_sat_lookahead_split, SMTOption(0), msg);
+    workerConfig->setOption(SMTConfig::o_sat_pure_lookahead, SMTOption(0), msg);
+    return workerConfig;
+}
+
+std::unique_ptr<Model> ParallelWorker::getModel(UserSymbols const & symbols) {
+    auto workerModel = solver->getModel();
+    TermTranslator fromWorker(*logic, userLogic);
+
+    Model::Evaluation evaluation;
+    for (PTRef var : symbols.variables) {
+        PTRef value = workerModel->evaluate(toWorker.translate(var));
+        evaluation.emplace(var, fromWorker.translate(value));
+    }
+    Model::SymbolDefinition definitions;
+    for (SymRef sym : symbols.functions) {
+        TemplateFunction workerDefinition = workerModel->getDefinition(toWorker.translateUFSymbol(sym));
+        vec<PTRef> formalArgs;
+        for (PTRef arg : workerDefinition.getArgs()) {
+            formalArgs.push(fromWorker.translate(arg));
+        }
+        definitions.emplace(sym, TemplateFunction(userLogic.getSymName(sym), formalArgs,
+                                                  fromWorker.translateSort(workerDefinition.getRetSort()),
+                                                  fromWorker.translate(workerDefinition.getBody())));
+    }
+    return std::make_unique<Model>(userLogic, std::move(evaluation), std::move(definitions));
+}
@@ -0,0 +1,42 @@
+#ifndef OPENSMT_PARALLELWORKER_H
+#define OPENSMT_PARALLELWORKER_H
+
+#include "MainSolver.h"
+#include "TermTranslator.h"
+
+#include <memory>
+#include <unordered_set>
+
+/**
+ * A solver owning private copies of the logic and the configuration, so that it can run in its own thread.
+ *
+ * Formulas stated in the user's logic are translated to the worker, and models found by the worker are translated
+ * back.  The worker must only be accessed from one thread at a time.
+ */
+class ParallelWorker {
+public:
+    // The symbols of the user's logic that a translated model needs to cover
+    struct UserSymbols {
+        std::unordered_set<PTRef, PTRefHash> variables;
+        std::unordered_set<SymRef, SymRefHash> functions;
+        void collect(Logic const & logic, PTRef fla);
+    };
+
+    ParallelWorker(Logic & userLogic, std::unique_ptr<SMTConfig> config, std::string const & name);
+
+    PTRef translate(PTRef tr) { return toWorker.translate(tr); }
+    MainSolver & getSolver() { return *solver; }
+    std::unique_ptr<Model> getModel(UserSymbols const & symbols);
+
+    // A configuration with the options of base, excluding the ones that make no sense for a worker, such as splitting
+    static std::unique_ptr<SMTConfig> createConfig(SMTConfig const & base);
+
+private:
+    Logic & userLogic;
+    std::unique_ptr<Logic> logic;
+    std::unique_ptr<SMTConfig> config;
+    std::unique_ptr<MainSolver> solver;
+    TermTranslator toWorker;
+};
+
+#endif //OPENSMT_PARALLELWORKER_H
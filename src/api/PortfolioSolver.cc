@@ -0,0 +1,133 @@
+#include "PortfolioSolver.h"
+
+#include <atomic>
+#include <exception>
+#include <thread>
+
+PortfolioSolver::PortfolioSolver(Logic & logic, SMTConfig & config, std::string const & name, unsigned int numberOfWorkers)
+    : logic(logic)
+    , config(config)
+{
+    if (numberOfWorkers == 0) { throw OsmtApiException("Portfolio needs at least one worker"); }
+    config.setUsedForInitiliazation();
+    for (unsigned int i = 0; i < numberOfWorkers; i++) {
+        workers.push_back(std::make_unique<ParallelWorker>(logic, createWorkerConfig(i), name + "-" + std::to_string(i)));
+    }
+    // The workers receive the same formulas in the same order, so their term mappers number the variables the same way
+    if (numberOfWorkers > 1 and not config.produce_inter()) {
+        clauseChannel = std::make_unique<ClauseChannel>(numberOfWorkers);
+        for (unsigned int i = 0; i < numberOfWorkers; i++) {
+            workers[i]->getSolver().getSMTSolver().connectClauseChannel(*clauseChannel, i);
+        }
+    }
+}
+
+PortfolioSolver::~PortfolioSolver() = default;
+
+/*
+ * Worker 0 runs with the user's configuration, the others vary the parameters of the SAT search.
+ */
+std::unique_ptr<SMTConfig> PortfolioSolver::createWorkerConfig(unsigned int index) const {
+    auto workerConfig = ParallelWorker::createConfig(config);
+    if (index == 0) { return workerConfig; }
+
+    static constexpr int restartFirst[] = { 100, 50, 200, 25 };
+    static constexpr double randomVarFreq[] = { 0.02, 0.0, 0.05, 0.1 };
+    static constexpr int rephaseInterval = 1000;
+
+    const char* msg;
+    int seed = config.getRandomSeed() + static_cast<int>(index) * 7919;
+    workerConfig->setRandomSeed(seed != 0 ? seed : 1);
+    workerConfig->sat_use_luby_restart = index % 2 == 0;
+    workerConfig->setOption(SMTConfig::o_restart_first, SMTOption(restartFirst[index % 4]), msg);
+    workerConfig->setOption(SMTConfig::o_random_var_freq, SMTOption(randomVarFreq[(index / 2) % 4]), msg);
+    workerConfig->setOption(SMTConfig::o_rnd_init_act, SMTOption(index % 3 == 2 ? 1 : 0), msg);
+    workerConfig->sat_theory_polarity_suggestion = index % 4 != 3;
+    if (index % 2 == 1 and config.sat_rephase_interval() == 0) {
+        workerConfig->setOption(SMTConfig::o_sat_rephase_interval, SMTOption(rephaseInterval), msg);
+    }
+    return workerConfig;
+}
+
+void PortfolioSolver::push() {
+    for (auto & worker : workers) {
+        worker->getSolver().push();
+    }
+}
+
+bool PortfolioSolver::pop() {
+    bool res = true;
+    for (auto & worker : workers) {
+        res = worker->getSolver().pop() and res;
+    }
+    return res;
+}
+
+void PortfolioSolver::insertFormula(PTRef fla) {
+    if (logic.getSortRef(fla) != logic.getSort_bool()) {
+        throw OsmtApiException(std::string("Top-level assertion sort must be ") + Logic::s_sort_bool + ", got " + logic.printSort(logic.getSortRef(fla)));
+    }
+    symbols.collect(logic, fla);
+    for (auto & worker : workers) {
+        worker->getSolver().insertFormula(worker->translate(fla));
+    }
+}
+
+sstat PortfolioSolver::check() {
+    std::atomic<int> decided{-1};
+    std::vector<sstat> results(workers.size(), s_Undef);
+    std::vector<std::exception_ptr> errors(workers.size());
+
+    for (auto & worker : workers) {
+        worker->getSolver().getSMTSolver().stop = false;
+    }
+
+    auto run = [&](unsigned int i) {
+        try {
+            results[i] = workers[i]->getSolver().check();
+        } catch (...) {
+            results[i] = s_Error;
+            errors[i] = std::current_exception();
+        }
+        if (results[i] == s_True or results[i] == s_False) {
+            int none = -1;
+            if (decided.compare_exchange_strong(none, static_cast<int>(i))) {
+                for (unsigned int j = 0; j < workers.size(); j++) {
+                    if (j != i) { workers[j]->getSolver().stop(); }
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers.size());
+    for (unsigned int i = 0; i < workers.size(); i++) {
+        threads.emplace_back(run, i);
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    winner = decided.load();
+    if (winner >= 0) {
+        status = results[winner];
+        return status;
+    }
+    for (auto const & error : errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+    status = s_Undef;
+    return status;
+}
+
+void PortfolioSolver::stop() {
+    for (auto & worker : workers) {
+        worker->getSolver().stop();
+    }
+}
+
+std::unique_ptr<Model> PortfolioSolver::getModel() {
+    if (status != s_True) { throw OsmtApiException("Model cannot be created if solver is not in SAT state"); }
+    assert(winner >= 0);
+    return workers[winner]->getModel(symbols);
+}
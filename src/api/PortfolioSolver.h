@@ -0,0 +1,47 @@
+#ifndef OPENSMT_PORTFOLIOSOLVER_H
+#define OPENSMT_PORTFOLIOSOLVER_H
+
+#include "ParallelWorker.h"
+
+#include <memory>
+#include <vector>
+
+/**
+ * Runs several differently configured solvers on the same problem in parallel threads.
+ *
+ * Every worker owns a private copy of the logic, the term mapper and the SAT solver, so no term or solver state is
+ * shared between the threads.  Formulas inserted by the user are translated to each worker.  The first worker to give
+ * a definitive answer wins and the others are interrupted through CoreSMTSolver::stop.  The workers exchange their
+ * short learnt clauses and units through a ClauseChannel.
+ */
+class PortfolioSolver {
+    Logic & logic;
+    SMTConfig & config;
+    std::unique_ptr<ClauseChannel> clauseChannel;
+    std::vector<std::unique_ptr<ParallelWorker>> workers;
+    ParallelWorker::UserSymbols symbols; // Symbols appearing in the inserted formulas
+    sstat status = s_Undef;
+    int winner = -1;
+
+    std::unique_ptr<SMTConfig> createWorkerConfig(unsigned int index) const;
+
+public:
+    PortfolioSolver(Logic & logic, SMTConfig & config, std::string const & name, unsigned int numberOfWorkers);
+    ~PortfolioSolver();
+
+    void push();
+    bool pop();
+    void insertFormula(PTRef fla);
+
+    sstat check();
+    void stop();
+
+    sstat getStatus() const { return status; }
+    std::unique_ptr<Model> getModel();
+
+    unsigned int getNumberOfWorkers() const { return workers.size(); }
+    int getWinner() const { return winner; } // Index of the worker that decided the last query, -1 if none
+    MainSolver & getWorker(unsigned int index) { return workers[index]->getSolver(); }
+};
+
+#endif //OPENSMT_PORTFOLIOSOLVER_H
@@ -8,21 +8,44 @@ Copyright (c) 2008, 2009 Centre national de la recherche scientifique (CNRS)
 #include <sstream>
 #include <algorithm>
 
+FastRational::mpqPool::~mpqPool()
+{
+    trim();
+    poolDestroyed = true;
+}
+
 mpq_ptr FastRational::mpqPool::alloc()
 {
-    mpq_ptr r;
+    ++statistics.spills;
     if (!pool.empty()) {
-        r = pool.top();
-        pool.pop();
-    } else {
-        r = store.emplace().get_mpq_t();
+        mpq_ptr r = pool.back();
+        pool.pop_back();
+        return r;
     }
+    ++statistics.allocations;
+    mpq_ptr r = new __mpq_struct;
+    mpq_init(r);
     return r;
 }
 
 void FastRational::mpqPool::release(mpq_ptr ptr)
 {
-    pool.push(ptr);
+    if (pool.size() < maxSize) {
+        pool.push_back(ptr);
+    } else {
+        ++statistics.frees;
+        freeMpq(ptr);
+    }
+}
+
+void FastRational::mpqPool::trim()
+{
+    statistics.frees += pool.size();
+    for (mpq_ptr ptr : pool) {
+        freeMpq(ptr);
+    }
+    pool.clear();
+    pool.shrink_to_fit();
 }
 
 FastRational::FastRational( const char * s, const int base )
@@ -39,7 +62,7 @@ FastRational::FastRational( const char * s, const int base )
 
 FastRational::FastRational(mpz_t z)
 {
-    if (mpz_fits_sint_p(z)) {
+    if (mpz_fits_slong_p(z)) {
         num = mpz_get_si(z);
         den = 1;
         state = State::WORD_VALID;
@@ -51,9 +74,9 @@ FastRational::FastRational(mpz_t z)
     }
 }
 
-FastRational::FastRational(uint32_t x)
+FastRational::FastRational(uword x)
 {
-    if (x > INT_MAX) {
+    if (x > WORD_MAX) {
         mpq = pool.alloc();
         mpq_set_ui(mpq, x, 1);
         state = State::MPQ_ALLOCATED_AND_VALID;
@@ -150,12 +173,12 @@ FastRational fastrat_fdiv_q(FastRational const & n, FastRational const & d) {
         word num = n.num;
         word den = d.num;
         word quo;
-        if (num == INT_MIN) // The abs is guaranteed to overflow.  Otherwise this is always fine
+        if (num == WORD_MIN) // The abs is guaranteed to overflow.  Otherwise this is always fine
             goto overflow;
-        // After this -INT_MIN+1 <= numerator <= INT_MAX, and therefore the result always fits into a word.
+        // After this -WORD_MIN+1 <= numerator <= WORD_MAX, and therefore the result always fits into a word.
         quo = num / den;
         if (num % den != 0 && ((num < 0 && den >=0) || (den < 0 && num >= 0))) // The result should be negative
-            quo--; // INT_MAX-1 >= quo >= -INT_MIN
+            quo--; // WORD_MAX-1 >= quo >= -WORD_MIN
 
         return quo;
     }
@@ -11,18 +11,22 @@ Copyright (c) 2008, 2009 Centre national de la recherche scientifique (CNRS)
 #include <cassert>
 #include <climits>
 #include "Vec.h"
-#include <stack>
 #include <vector>
 
-typedef int32_t  word;
-typedef uint32_t uword;
-typedef int64_t  lword;
-typedef uint64_t ulword;
-#define WORD_MIN  INT_MIN
-#define WORD_MAX  INT_MAX
-#define UWORD_MAX UINT_MAX
-#define LWORD_MIN LONG_MIN
-#define LWORD_MAX LONG_MAX
+// The word representation holds 64-bit numerators and denominators.  The intermediate results of the operations on
+// words are computed in 128 bits, where the products of two words always fit.
+typedef int64_t  word;
+typedef uint64_t uword;
+typedef __int128 lword;
+typedef unsigned __int128 ulword;
+#define WORD_MIN  INT64_MIN
+#define WORD_MAX  INT64_MAX
+#define UWORD_MAX UINT64_MAX
+#define LWORD_MAX (static_cast<lword>(~static_cast<ulword>(0) >> 1))
+#define LWORD_MIN (-LWORD_MAX - 1)
+
+// The word values are exchanged with GMP through its long integer interface
+static_assert(sizeof(long) == sizeof(word), "FastRational requires 64-bit long");
 
 enum class State: unsigned char {
     /*
@@ -67,22 +71,37 @@ inline ulword absVal(lword x) {
                  : +((ulword)(x));
 }
 
+// Per-thread counters of the GMP storage used by FastRational
+struct MpqPoolStatistics {
+    uint64_t spills = 0;      // How many times a value needed mpq storage because it did not fit the word representation
+    uint64_t allocations = 0; // How many of those were served by allocating new mpq storage instead of reusing a pooled one
+    uint64_t frees = 0;       // How many mpq values were returned to the heap
+};
+
 class FastRational
 {
+    // Caches unused mpq values of a thread.  Every value is allocated separately, so a value allocated in one thread can
+    // be released to the pool of another thread.  Each thread has its own pool, and the pool has a bounded size.
     class mpqPool
     {
-        std::stack<mpq_class> store; // uses deque as storage to avoid realloc
-        std::stack<mpq_ptr, std::vector<mpq_ptr>> pool;
+        std::vector<mpq_ptr> pool;
+        static constexpr std::size_t maxSize = 1u << 13;
+        static inline void freeMpq(mpq_ptr ptr) { mpq_clear(ptr); delete ptr; }
     public:
+        MpqPoolStatistics statistics;
+        ~mpqPool();
         mpq_ptr alloc();
         void release(mpq_ptr);
+        void trim();
+        static void releaseAfterDestruction(mpq_ptr ptr) { freeMpq(ptr); }
     };
     State state;
     word num{0};
     uword den{1};
     mpq_ptr mpq{nullptr};
 
-    inline static mpqPool pool;
+    inline static thread_local mpqPool pool;
+    inline static thread_local bool poolDestroyed = false; // Values with static storage can outlive the pool of the main thread
     inline static thread_local mpz_class temp;
     inline static mpz_ptr mpz() { return temp.get_mpz_t(); }
 
@@ -121,7 +140,9 @@ public:
     //
     FastRational       () : state{State::WORD_VALID}, num(0), den(1) {}
     FastRational       (word x) : state{State::WORD_VALID}, num(x), den(1) {}
-    FastRational       (uint32_t);
+    FastRational       (int x) : FastRational(word(x)) {}
+    FastRational       (uint32_t x) : FastRational(word(x)) {}
+    FastRational       (uword);
     inline FastRational(word n, uword d);
     // The string must be in the format accepted by mpq_set_str, e.g., "1/2"
     explicit FastRational(const char* s, const int base = 10);
@@ -144,11 +165,20 @@ public:
 
     void reset();
     inline FastRational & operator=( const FastRational & );
+
+    // Statistics of the mpq storage used by the calling thread
+    static MpqPoolStatistics const & getMpqPoolStatistics() { return pool.statistics; }
+    // Returns the cached mpq storage of the calling thread to the heap
+    static void trimMpqPool() { pool.trim(); }
 private:
     void kill_mpq()
     {
         if (mpqMemoryAllocated()) {
-            pool.release(mpq);
+            if (poolDestroyed) {
+                mpqPool::releaseAfterDestruction(mpq);
+            } else {
+                pool.release(mpq);
+            }
             state = State::WORD_VALID;
         }
     }
@@ -178,7 +208,7 @@ private:
     bool fitsWord() const
     {
         assert(not wordPartValid() and mpqPartValid()); // Do not call this method if word part is already valid
-        return mpz_fits_sint_p(mpq_numref(mpq)) and mpz_fits_uint_p(mpq_denref(mpq));
+        return mpz_fits_slong_p(mpq_numref(mpq)) and mpz_fits_ulong_p(mpq_denref(mpq));
     }
 
     //
@@ -228,8 +258,8 @@ public:
     inline void negate();
 
     FastRational get_den() const {
-        if (wordPartValid() && den <= INT32_MAX) {
-            return FastRational((uword)den);
+        if (wordPartValid() && den <= WORD_MAX) {
+            return FastRational((word)den);
         }
         else {
             force_ensure_mpq_valid();
@@ -256,7 +286,7 @@ public:
 
     uint32_t getHashValue() const {
         if  (wordPartValid()) {
-            return 37*(uint32_t)num + 13*(uint32_t)den;
+            return 37*(uint32_t)(num ^ (num >> 32)) + 13*(uint32_t)(den ^ (den >> 32));
         }
         else {
             uint32_t h_n = 2166136261U;
@@ -278,7 +308,7 @@ public:
             return den == 1;
         else {
             assert(mpqPartValid());
-            return mpz_fits_uint_p(mpq_denref(mpq)) && (mpz_get_ui(mpq_denref(mpq)) == 1);
+            return mpz_fits_ulong_p(mpq_denref(mpq)) && (mpz_get_ui(mpq_denref(mpq)) == 1);
         }
     }
     inline FastRational ceil() const
@@ -387,8 +417,13 @@ public:
     FastRational operator%(const FastRational& d) {
         assert(isInteger() && d.isInteger());
         if (wordPartValid() && d.wordPartValid()) {
-            uword w = absVal(num % d.num);  // Largest value is absVal(INT_MAX % INT_MIN) = INT_MAX
-            return (word)(d.num > 0 ? w : -w); // No overflow since 0 <= w <= INT_MAX
+            if (d.num == -1) { return 0; } // WORD_MIN % -1 overflows
+            // The remainder of the floor division, as computed below for the mpq values
+            word r = num % d.num;
+            if (r != 0 and (r < 0) != (d.num < 0)) {
+                r += d.num; // No overflow since r and d.num have different signs
+            }
+            return r;
         }
         FastRational r = (*this) / d;
         r = r.floor();
@@ -529,6 +564,21 @@ template<typename integer> integer gcd(integer a, integer b) {
     }
 }
 
+// The division of 32-bit words is considerably faster than that of 64-bit words, and most of the values are small
+inline uword divideWords(uword a, uword b) {
+    return ((a | b) >> 32) == 0 ? uword(uint32_t(a) / uint32_t(b)) : a / b;
+}
+
+template<> inline uword gcd<uword>(uword a, uword b) {
+    while (((a | b) >> 32) != 0) {
+        if (a == 0) return b;
+        if (b == 0) return a;
+        if (b > a) { std::swap(a, b); }
+        a %= b;
+    }
+    return gcd<uint32_t>(uint32_t(a), uint32_t(b));
+}
+
 template<typename integer>
 FastRational lcm(integer a, integer b) {
     if (a == 0) return 0;
@@ -548,8 +598,25 @@ inline int cmpabs(FastRational op1, FastRational op2)
         op2 = -op2;
     return op1.compare(op2);
 };
-template<ulword> ulword gcd(ulword a, ulword b);
-template<uword> uword gcd(uword a, uword b);
+// The remainders of 128-bit values are expensive, so the gcd switches to words as soon as the values fit
+inline ulword gcd(ulword a, ulword b) {
+    while ((a >> 64) != 0 or (b >> 64) != 0) {
+        if (a == 0) return b;
+        if (b == 0) return a;
+        if (b > a) { std::swap(a, b); }
+        a %= b;
+    }
+    return gcd<uword>(uword(a), uword(b));
+}
+
+// Division by a word.  A dividend that fits a word is divided in words since the 128-bit division is a library call.
+inline ulword divideByWord(ulword a, uword b) {
+    return (a >> 64) == 0 ? ulword(divideWords(uword(a), b)) : a / b;
+}
+inline lword divideByWord(lword a, uword b) {
+    ulword q = divideByWord(absVal(a), b);
+    return a < 0 ? lword(-q) : lword(q);
+}
 #define CHECK_WORD(var, value)                  \
     do {                                        \
         lword tmp = value;                      \
@@ -562,22 +629,16 @@ template<uword> uword gcd(uword a, uword b);
 // Adapted from https://codereview.stackexchange.com/questions/37177/simple-method-to-detect-int-overflow
 #define CHECK_SUM_OVERFLOWS_LWORD(var, s1, s2) \
     do {                                       \
-        if (s1 > 0 and s2 > LWORD_MAX - s1) {  \
-            goto overflow;                     \
-        } if (s1 < 0 and s2 < LWORD_MIN - s1) {\
+        if (__builtin_add_overflow(s1, s2, &var)) { \
             goto overflow;                     \
         }                                      \
-        var = s1 + s2;                         \
     } while (0)                                \
 
 #define CHECK_SUB_OVERFLOWS_LWORD(var, s1, s2) \
     do {                                       \
-        if (s1 >= 0 and s2 < s1 - LWORD_MAX) { \
-            goto overflow;                     \
-        } if (s1 < 0 and s2 > (s1 + 1) + LWORD_MAX) { \
+        if (__builtin_sub_overflow(s1, s2, &var)) { \
             goto overflow;                     \
         }                                      \
-        var = s1 - s2;                         \
     } while (0)                                \
 
 #define CHECK_POSITIVE(value) \
@@ -619,8 +680,10 @@ inline FastRational::FastRational(word n, uword d) : state{State::WORD_VALID} {
     } else {
         uword common = gcd<uword>(absVal(n), d);
         if (common > 1) {
-            num = n / common;
-            den = d / common;
+            // Divide the absolute value since the division by an unsigned word would convert n to unsigned
+            uword q = divideWords(absVal(n), common);
+            num = n < 0 ? -word(q) : word(q);
+            den = divideWords(d, common);
         } else {
             num = n;
             den = d;
@@ -628,6 +691,33 @@ inline FastRational::FastRational(word n, uword d) : state{State::WORD_VALID} {
     }
 }
 
+// The sum or the difference of two fractions of words computed in words.  Returns false if an intermediate value does
+// not fit a word, in which case the result has to be computed in 128 bits.  The results of the operations on small
+// values are computed here since the 128-bit arithmetic is considerably slower.
+template<bool subtract>
+inline bool sumInWords(word an, uword ad, word bn, uword bd, word & zn, uword & zd) {
+    uword common = gcd(ad, bd);
+    uword af = divideWords(bd, common);
+    uword bf = divideWords(ad, common);
+    word n1, n2, n;
+    uword d;
+    if (__builtin_mul_overflow(an, af, &n1) or __builtin_mul_overflow(bn, bf, &n2)
+        or (subtract ? __builtin_sub_overflow(n1, n2, &n) : __builtin_add_overflow(n1, n2, &n))
+        or __builtin_mul_overflow(ad, af, &d)) {
+        return false;
+    }
+    common = gcd(absVal(n), d);
+    if (common > 1) {
+        uword q = divideWords(absVal(n), common);
+        zn = n < 0 ? -word(q) : word(q);
+        zd = divideWords(d, common);
+    } else {
+        zn = n;
+        zd = d;
+    }
+    return true;
+}
+
 inline void addition(FastRational& dst, const FastRational& a, const FastRational& b) {
     if (a.wordPartValid() && b.wordPartValid()) {
         if (b.num == 0) {
@@ -640,8 +730,8 @@ inline void addition(FastRational& dst, const FastRational& a, const FastRationa
             dst.num = 0;
             dst.den = 1;
         } else if (b.den == 1) {
-            // Maximum sum here is INT_MAX + INT_MAX*UINT_MAX, which does not overflow.
-            // Minimum sum here is INT_MIN + UINT_MAX*INT_MIN = 2^63, which does not overflow.
+            // Maximum sum here is WORD_MAX + WORD_MAX*UWORD_MAX, which does not overflow.
+            // Minimum sum here is WORD_MIN + UWORD_MAX*WORD_MIN = -2^127, which does not overflow.
             // (a.num + b.num*a.den)/a.den is already canonicalized as can be seen with simple number theory.
             lword num_tmp = lword(a.num) + lword(b.num)*a.den;
             CHECK_WORD(dst.num, num_tmp);
@@ -651,25 +741,27 @@ inline void addition(FastRational& dst, const FastRational& a, const FastRationa
             lword num_tmp = lword(b.num) + lword(a.num)*b.den;
             CHECK_WORD(dst.num, num_tmp);
             dst.den = b.den;
+        } else if (sumInWords<false>(a.num, a.den, b.num, b.den, dst.num, dst.den)) {
+            // The common case where the intermediate values fit words
         } else {
             uword common = gcd(a.den, b.den);
             lword n1, n2;
             if (common != 1) {
-                n1 = lword(a.num) * (b.den / common);
-                n2 = lword(b.num) * (a.den / common);
+                n1 = lword(a.num) * divideWords(b.den, common);
+                n2 = lword(b.num) * divideWords(a.den, common);
             } else {
                 n1 = lword(a.num) * b.den;
                 n2 = lword(b.num) * a.den;
             }
             lword n;
             CHECK_SUM_OVERFLOWS_LWORD(n, n1, n2);
-            ulword d = ulword(a.den) * (b.den / common);
+            ulword d = ulword(a.den) * divideWords(b.den, common);
             common = gcd(absVal(n), d);
             word zn;
             uword zd;
             if (common != 1) {
-                CHECK_WORD(zn, n / common);
-                CHECK_UWORD(zd, d / common);
+                CHECK_WORD(zn, divideByWord(n, common));
+                CHECK_UWORD(zd, divideByWord(d, common));
             } else {
                 CHECK_WORD(zn, n);
                 CHECK_UWORD(zd, d);
@@ -702,8 +794,8 @@ inline void substraction(FastRational& dst, const FastRational& a, const FastRat
             dst.num = 0;
             dst.den = 1;
         } else if (b.den == 1) {
-            // Maximum subtraction here is INT_MAX - (INT_MIN)*(UINT_MAX) = 2^63-1 which does not overflow lword
-            // Minimum subtraction here is INT_MIN - (INT_MAX)*(UINT_MAX) = -9223372028264841217 which does not underflow lword
+            // Maximum subtraction here is WORD_MAX - (WORD_MIN)*(UWORD_MAX) = 2^127-1 which does not overflow lword
+            // Minimum subtraction here is WORD_MIN - (WORD_MAX)*(UWORD_MAX) = -2^127+2^64-1 which does not underflow lword
             // (a.num - b.num*a.den) / a.den is already canonicalized
             CHECK_WORD(dst.num, lword(a.num) - lword(b.num)*a.den);
             dst.den = a.den;
@@ -711,23 +803,24 @@ inline void substraction(FastRational& dst, const FastRational& a, const FastRat
             // (a.num*b.den - b.den)/b.den is already canonicalized.
             CHECK_WORD(dst.num, lword(a.num)*b.den - lword(b.num));
             dst.den = b.den;
+        } else if (sumInWords<true>(a.num, a.den, b.num, b.den, dst.num, dst.den)) {
+            // The common case where the intermediate values fit words
         } else {
             uword common = gcd(a.den, b.den);
             lword n1, n2, n;
             ulword d;
             if (common != 1) {
-                // Worst case for n1-n2 seems to be
-                // - 2147483647/4294967292 - 2147483645/4294967294
-                // This does not overflow.  The positive case is the same
-                n1 = lword(a.num) * (b.den / common);
-                n2 = lword(b.num) * (a.den / common);
+                // Since common >= 2, both products are at most 2^63 * UWORD_MAX / 2 in absolute value,
+                // and their difference does not overflow.  The positive case is the same
+                n1 = lword(a.num) * divideWords(b.den, common);
+                n2 = lword(b.num) * divideWords(a.den, common);
                 n = n1 - n2;
 //                CHECK_SUB_OVERFLOWS_LWORD(n, n1, n2);
-                d = ulword(a.den) * (b.den / common);
+                d = ulword(a.den) * divideWords(b.den, common);
             } else {
                 n1 = lword(a.num) * b.den;
                 n2 = lword(b.num) * a.den;
-                // Consider -2147483645/4294967294 - 2147483647/4294967295.  The following underflows lword
+                // Consider -(2^63-3)/(2^64-2) - (2^63-1)/(2^64-1).  The following underflows lword
                 CHECK_SUB_OVERFLOWS_LWORD(n, n1, n2);
                 d = ulword(a.den) * b.den;
             }
@@ -736,8 +829,8 @@ inline void substraction(FastRational& dst, const FastRational& a, const FastRat
             word zn;
             uword zd;
             if (common != 1) {
-                CHECK_WORD(zn, n / common);
-                CHECK_UWORD(zd, d / common);
+                CHECK_WORD(zn, divideByWord(n, common));
+                CHECK_UWORD(zd, divideByWord(d, common));
             } else {
                 CHECK_WORD(zn, n);
                 CHECK_UWORD(zd, d);
@@ -780,15 +873,15 @@ inline void multiplication(FastRational& dst, const FastRational& a, const FastR
         lword k1, k2;
         ulword k3, k4; // Changed lword => ulword
         if (common1 > 1) {
-            k1 = lword(a.num)/common1;
-            k4 = ulword(b.den)/common1;
+            k1 = divideByWord(lword(a.num), common1);
+            k4 = divideWords(b.den, common1);
         } else {
             k1 = lword(a.num);
             k4 = ulword(b.den);
         }
         if (common2 > 1) {
-            k2 = lword(b.num)/common2;
-            k3 = ulword(a.den)/common2;
+            k2 = divideByWord(lword(b.num), common2);
+            k3 = divideWords(a.den, common2);
         } else {
             k2 = lword(b.num);
             k3 = ulword(a.den);
@@ -829,8 +922,8 @@ inline void division(FastRational& dst, const FastRational& a, const FastRationa
         uword common2 = gcd(a.den, b.den);
         word zn;
         uword zd;
-        CHECK_WORD(zn, ulword(absVal(a.num)/common1) * (b.den/common2));
-        CHECK_UWORD(zd, ulword(absVal(b.num)/common1) * (a.den/common2));
+        CHECK_WORD(zn, ulword(divideWords(absVal(a.num), common1)) * divideWords(b.den, common2));
+        CHECK_UWORD(zd, ulword(divideWords(absVal(b.num), common1)) * divideWords(a.den, common2));
 
         // Note: dst and a or b might be the same FastRational.
         bool b_num_lt_0 = b.num < 0;
@@ -875,18 +968,29 @@ inline void additionAssign(FastRational& a, const FastRational& b) {
             } else if (a.num == 0) {
                 a.num = b.num;
                 a.den = b.den;
+            } else if (sumInWords<false>(a.num, a.den, b.num, b.den, a.num, a.den)) {
+                // The common case where the intermediate values fit words
             } else {
-                lword c1 = lword(a.num)*b.den; // No overflow
-                lword c2 = lword(b.num)*a.den; // No overflow
+                // As in addition: with the gcd of the denominators divided out, the remaining common factor of the
+                // sum and the denominator divides that gcd, so it fits a word
+                uword common = gcd(a.den, b.den);
+                lword c1, c2;
+                if (common != 1) {
+                    c1 = lword(a.num) * divideWords(b.den, common);
+                    c2 = lword(b.num) * divideWords(a.den, common);
+                } else {
+                    c1 = lword(a.num) * b.den; // No overflow
+                    c2 = lword(b.num) * a.den; // No overflow
+                }
                 lword n;
                 CHECK_SUM_OVERFLOWS_LWORD(n, c1, c2); // Overflow possible
-                ulword d = ulword(a.den) * b.den;
-                lword common = gcd(absVal(n), d);
+                ulword d = ulword(a.den) * divideWords(b.den, common);
+                common = gcd(absVal(n), d);
                 word zn;
                 uword zd;
-                if (common > 1) {
-                    CHECK_WORD(zn, n/common);
-                    CHECK_UWORD(zd, d/common);
+                if (common != 1) {
+                    CHECK_WORD(zn, divideByWord(n, common));
+                    CHECK_UWORD(zd, divideByWord(d, common));
                 } else {
                     CHECK_WORD(zn, n);
                     CHECK_UWORD(zd, d);
@@ -909,17 +1013,22 @@ inline void additionAssign(FastRational& a, const FastRational& b) {
 
 inline void substractionAssign(FastRational& a, const FastRational& b) {
     if (a.wordPartValid() && b.wordPartValid()) {
+        if (sumInWords<true>(a.num, a.den, b.num, b.den, a.num, a.den)) {
+            a.setOnlyWordPartValid();
+            assert(a.isWellFormed());
+            return;
+        }
         uword common = gcd(a.den, b.den);
-        COMPUTE_WORD(n1, lword(a.num) * (b.den / common));
-        COMPUTE_WORD(n2, lword(b.num) * (a.den / common));
+        COMPUTE_WORD(n1, lword(a.num) * divideWords(b.den, common));
+        COMPUTE_WORD(n2, lword(b.num) * divideWords(a.den, common));
         lword n = lword(n1) - lword(n2); // Cannot overflow
-        ulword d = ulword(a.den) * (b.den / common);
+        ulword d = ulword(a.den) * divideWords(b.den, common);
         common = gcd(absVal(n), d);
         word zn;
         uword zd;
         if (common > 1) {
-            CHECK_WORD(zn, n / common);
-            CHECK_UWORD(zd, d / common);
+            CHECK_WORD(zn, divideByWord(n, common));
+            CHECK_UWORD(zd, divideByWord(d, common));
         } else {
             CHECK_WORD(zn, n);
             CHECK_UWORD(zd, d);
@@ -945,8 +1054,8 @@ inline void multiplicationAssign(FastRational& a, const FastRational& b) {
         word zn;
         uword zd;
         // Without the absVal, this fails for a.num < 0 when common1 > 1 and b.num < 0 when common2 > 1 since the result of the division is unsigned.
-        CHECK_WORD(zn, lword(common1 > 1 ? absVal(a.num)/common1 : absVal(a.num)) * (common2 > 1 ? absVal(b.num)/common2 : absVal(b.num)));
-        CHECK_UWORD(zd, ulword(common2 > 1 ? a.den/common2 : a.den) * (common1 > 1 ? b.den/common1 : b.den));
+        CHECK_WORD(zn, lword(common1 > 1 ? divideWords(absVal(a.num), common1) : absVal(a.num)) * (common2 > 1 ? divideWords(absVal(b.num), common2) : absVal(b.num)));
+        CHECK_UWORD(zd, ulword(common2 > 1 ? divideWords(a.den, common2) : a.den) * (common1 > 1 ? divideWords(b.den, common1) : b.den));
 
         bool b_num_lt_0 = b.num < 0;
         bool a_num_ge_0 = a.num >= 0;
@@ -977,8 +1086,8 @@ inline void divisionAssign(FastRational& a, const FastRational& b) {
         uword common2 = gcd(a.den, b.den);
         word zn;
         uword zd;
-        CHECK_WORD(zn, ulword(absVal(a.num) / common1) * (b.den / common2));
-        CHECK_UWORD(zd, ulword(absVal(b.num) / common1) * (a.den / common2));
+        CHECK_WORD(zn, ulword(divideWords(absVal(a.num), common1)) * divideWords(b.den, common2));
+        CHECK_UWORD(zd, ulword(divideWords(absVal(b.num), common1)) * divideWords(a.den, common2));
 
         bool b_num_lt_0 = b.num < 0;
         bool a_num_ge_0 = a.num >= 0;
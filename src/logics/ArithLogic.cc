@@ -7,7 +7,9 @@
 #include "FastRational.h"
 #include "OsmtInternalException.h"
 #include "OsmtApiException.h"
+#include <algorithm>
 #include <memory>
+#include <unordered_map>
 #include <sstream>
 const std::string ArithLogic::e_nonlinear_term = "Logic does not support nonlinear terms";
 
@@ -241,37 +243,110 @@ PTRef ArithLogic::normalizeMul(PTRef mul)
     }
 }
 
+namespace {
+// Longer equalities are not used for elimination, since substituting their definitions makes the rows of the tableau
+// denser and the back-substitution fills in the earlier definitions
+constexpr std::ptrdiff_t maxEliminationSize = 8;
+
+// Scales an equality over integer variables to coprime integer coefficients.  Returns false if the equality has no
+// integer solution, that is, if the gcd of the coefficients does not divide the constant.
+bool normalizeIntegerEquality(LAExpression & equality) {
+    opensmt::Real divisor = 0;
+    for (auto const & [var, coeff] : equality) {
+        if (var == PTRef_Undef) { continue; }
+        if (not coeff.isInteger()) { return true; }
+        divisor = gcd(divisor, coeff.sign() < 0 ? opensmt::Real(-coeff) : coeff);
+    }
+    if (divisor.isZero()) { return true; }
+    if (not (equality.getCoeff(PTRef_Undef) / divisor).isInteger()) { return false; }
+    if (divisor.isOne()) { return true; }
+    for (auto & term : equality) {
+        term.second /= divisor;
+    }
+    return true;
+}
+}
+
+//
+// Gauss-Jordan elimination on the top-level equalities.  Each equality is first rewritten with the definitions found
+// so far and then solved for one of its remaining variables, which is also eliminated from the earlier definitions.
+// The definitions are therefore in terms of the variables that are not eliminated, and the substitutions need no
+// transitive closure.  An integer variable is only eliminated if its coefficient is a unit after the equality has been
+// scaled to coprime integer coefficients, so that its definition has integer coefficients.  Equalities with more than
+// maxEliminationSize variables are only checked for consistency.
+//
 lbool ArithLogic::arithmeticElimination(const vec<PTRef> & top_level_arith, SubstMap & substitutions)
 {
-    std::vector<std::unique_ptr<LAExpression>> equalities;
-    ArithLogic& logic = *this;
+    std::vector<std::unique_ptr<LAExpression>> definitions;
+    std::vector<PTRef> definedVars;
+    std::unordered_map<PTRef, std::size_t, PTRefHash> definitionOf;
+    std::unordered_map<PTRef, std::vector<std::size_t>, PTRefHash> occurrences; // The definitions a variable may occur in
+
+    auto isEliminable = [&](LAExpression const & equality, PTRef var, opensmt::Real const & coeff) {
+        if (not isNumVarLike(var) or substitutions.has(var)) { return false; }
+        SRef sort = getSortRef(var);
+        for (auto const & [other, otherCoeff] : equality) {
+            if (other != PTRef_Undef and getSortRef(other) != sort) { return false; }
+        }
+        return sort != getSort_int() or coeff.isOne() or coeff == -1;
+    };
+
     // I don't know if reversing the order makes any sense but osmt1
     // does that.
     for (int i = top_level_arith.size() - 1; i >= 0; i--) {
-        equalities.emplace_back(new LAExpression(logic, top_level_arith[i]));
-    }
-
-    for (auto const& equality : equalities) {
-        PTRef res = equality->solve();
-        if (res == PTRef_Undef) { // MB: special case where the equality simplifies to "c = 0" with c constant
-            // This is a conflicting equality unless the constant "c" is also 0.
-            // We do nothing here and let the main code deal with this
-            continue;
+        auto equality = std::make_unique<LAExpression>(*this, top_level_arith[i], false);
+        std::vector<std::pair<PTRef, opensmt::Real>> defined;
+        for (auto const & [var, coeff] : *equality) {
+            if (var != PTRef_Undef and definitionOf.find(var) != definitionOf.end()) { defined.emplace_back(var, coeff); }
+        }
+        for (auto const & [var, coeff] : defined) {
+            equality->addExprWithCoeff(*definitions[definitionOf[var]], -coeff);
         }
-        auto sub = equality->getSubst();
-        PTRef var = sub.first;
-        assert(var != PTRef_Undef and isNumVarLike(var) and sub.second != PTRef_Undef);
-        if (substitutions.has(var)) {
-            if (logic.isConstant(sub.second)) {
-                substitutions[var] = sub.second;
+        if (equality->isFalse()) { return l_False; }
+        if (equality->isTrue()) { continue; }
+
+        bool const allIntegers = std::all_of(equality->begin(), equality->end(), [this](auto const & term) {
+            return term.first == PTRef_Undef or yieldsSortInt(term.first);
+        });
+        if (allIntegers and not normalizeIntegerEquality(*equality)) { return l_False; }
+        if (std::distance(equality->begin(), equality->end()) > maxEliminationSize + 1) { continue; }
+
+        // Prefer the variable occurring in the fewest definitions to limit the fill-in
+        PTRef var = PTRef_Undef;
+        std::size_t fillIn = 0;
+        for (auto const & [candidate, coeff] : *equality) {
+            if (candidate == PTRef_Undef or not isEliminable(*equality, candidate, coeff)) { continue; }
+            auto it = occurrences.find(candidate);
+            std::size_t candidateFillIn = it == occurrences.end() ? 0 : it->second.size();
+            if (var == PTRef_Undef or candidateFillIn < fillIn) {
+                var = candidate;
+                fillIn = candidateFillIn;
             }
-            // Already has substitution for this var, let the main substitution code deal with this situation
-            continue;
-        } else {
-            substitutions.insert(var, sub.second);
         }
+        if (var == PTRef_Undef) { continue; }
+        equality->solve(var);
+
+        for (std::size_t j : occurrences[var]) {
+            opensmt::Real coeff = definitions[j]->getCoeff(var);
+            if (coeff.isZero()) { continue; }
+            definitions[j]->addExprWithCoeff(*equality, -coeff);
+            for (auto const & term : *equality) {
+                if (term.first != PTRef_Undef and term.first != var) { occurrences[term.first].push_back(j); }
+            }
+        }
+        occurrences.erase(var);
+        for (auto const & term : *equality) {
+            if (term.first != PTRef_Undef and term.first != var) { occurrences[term.first].push_back(definitions.size()); }
+        }
+        definitionOf.emplace(var, definitions.size());
+        definedVars.push_back(var);
+        definitions.push_back(std::move(equality));
+    }
+
+    for (std::size_t i = 0; i < definitions.size(); ++i) {
+        auto [var, term] = definitions[i]->getSubst(definedVars[i]);
+        substitutions.insert(var, term);
     }
-    // To simplify this method, we do not try to detect a conflict here, so result is always l_Undef
     return l_Undef;
 }
 
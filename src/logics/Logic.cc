@@ -56,7 +56,6 @@ const char* Logic::s_abstract_value_prefix = "@";
 // The constructor initiates the base logic (Boolean)
 Logic::Logic(opensmt::Logic_t _logicType) :
       logicType(_logicType)
-    , distinctClassCount(0)
     , sort_store()
     , term_store(sym_store)
     , sym_IndexedSort(sort_store.newSortSymbol(SortSymbol(tk_indexed, 2, SortSymbol::INTERNAL)))
@@ -607,8 +606,7 @@ PTRef Logic::mkEq(vec<PTRef>&& args) {
 
 // Given args = {a_1, ..., a_n}, distinct(args) holds iff
 // for all a_i, a_j \in args s.t. i != j: a_i != a_j
-// General distinctions are represented as separate terms until the distinction classes have been used up.
-// After this, they are written explicitly as the O(n^2) expansion.
+// General distinctions are represented as separate terms; the theory decides whether to expand them.
 PTRef Logic::mkDistinct(vec<PTRef>&& args) {
     if (args.size() == 0) return getTerm_true();
     if (args.size() == 1) return getTerm_true();
@@ -637,21 +635,9 @@ PTRef Logic::mkDistinct(vec<PTRef>&& args) {
         return term_store.getFromCplxMap(key);
     }
     else {
-        if (distinctClassCount < maxDistinctClasses) {
-            PTRef res = term_store.newTerm(diseq_sym, key.args);
-            term_store.addToCplxMap(std::move(key), res);
-            distinctClassCount++;
-            return res;
-        }
-        else {
-            vec<PTRef> distinct_terms;
-            for (int i = 0; i < key.args.size(); i++) {
-                for (int j = i + 1; j < key.args.size(); j++) {
-                    distinct_terms.push(mkDistinct({key.args[i], key.args[j]}));
-                }
-            }
-            return mkAnd(std::move(distinct_terms));
-        }
+        PTRef res = term_store.newTerm(diseq_sym, key.args);
+        term_store.addToCplxMap(std::move(key), res);
+        return res;
     }
 }
 
@@ -1470,6 +1456,8 @@ SRef        Logic::getSortRef    (const SymRef sr)       const { return getSym(s
 
 std::string Logic::printSort(SRef s) const { return sort_store.printSort(s); }
 
+std::size_t Logic::getSortSize(SRef s) const { return sort_store.getSize(s); }
+
 SRef Logic::getUniqueArgSort(SymRef sr) const {
     SRef res = SRef_Undef;
     for (SRef a : getSym(sr)) {
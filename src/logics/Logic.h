@@ -48,7 +48,6 @@ class Logic {
     bool isKnownToUser(std::string_view name) const { return name[0] != s_abstract_value_prefix[0]; }
     bool isKnownToUser(SymRef sr) const { return isKnownToUser(getSymName(sr)); }
     std::size_t abstractValueCount = 0;
-    int distinctClassCount;
 
     class DefinedFunctions {
         std::unordered_map<std::string,TemplateFunction> defined_functions;
@@ -170,6 +169,8 @@ class Logic {
     SRef                getSortRef (SymRef sr) const;
     std::string         printSort  (SRef s)    const;
     std::size_t         getSortSize(SRef s)    const;
+    std::string         getSortSymName(SRef s) const { return sort_store.getSortSymName(s); }
+    SRef                getSortArg (SRef s, unsigned int i) const { return sort_store[s][i]; }
     SRef declareUninterpretedSort(std::string const &);
 
     SRef        getUniqueArgSort(SymRef sr)           const;
@@ -0,0 +1,79 @@
+#include "TermTranslator.h"
+
+#include "TreeOps.h"
+
+class TermTranslator::TranslationConfig : public DefaultVisitorConfig {
+    TermTranslator & translator;
+public:
+    TranslationConfig(TermTranslator & translator) : translator(translator) {}
+
+    bool previsit(PTRef tr) override { return translator.termCache.find(tr) == translator.termCache.end(); }
+    void visit(PTRef tr) override { translator.termCache.emplace(tr, translator.translateNode(tr)); }
+};
+
+TermTranslator::TermTranslator(Logic const & source, Logic & target) : source(source), target(target) {
+    if (source.getLogic() != target.getLogic()) {
+        throw OsmtApiException("Terms can only be translated between logics of the same type");
+    }
+}
+
+PTRef TermTranslator::translate(PTRef tr) {
+    auto it = termCache.find(tr);
+    if (it != termCache.end()) { return it->second; }
+    TranslationConfig config(*this);
+    TermVisitor<TranslationConfig>(source, config).visit(tr);
+    assert(termCache.find(tr) != termCache.end());
+    return termCache.at(tr);
+}
+
+SRef TermTranslator::translateSort(SRef sr) {
+    auto it = sortCache.find(sr);
+    if (it != sortCache.end()) { return it->second; }
+    vec<SRef> args;
+    for (std::size_t i = 0; i < source.getSortSize(sr); i++) {
+        args.push(translateSort(source.getSortArg(sr, i)));
+    }
+    SortSymbol symbol(source.getSortSymName(sr), args.size());
+    SSymRef ssr;
+    if (not target.peekSortSymbol(symbol, ssr)) {
+        ssr = target.declareSortSymbol(std::move(symbol));
+    }
+    SRef res = target.getSort(ssr, std::move(args));
+    sortCache.emplace(sr, res);
+    return res;
+}
+
+SymRef TermTranslator::translateUFSymbol(SymRef sr) {
+    assert(source.isUF(sr));
+    Symbol const & symbol = source.getSym(sr);
+    vec<SRef> argSorts;
+    for (uint32_t i = 0; i < symbol.nargs(); i++) {
+        argSorts.push(translateSort(symbol[i]));
+    }
+    return target.declareFun(source.getSymName(sr), translateSort(symbol.rsort()), argSorts);
+}
+
+PTRef TermTranslator::translateNode(PTRef tr) {
+    if (source.isTrue(tr)) { return target.getTerm_true(); }
+    if (source.isFalse(tr)) { return target.getTerm_false(); }
+
+    SymRef sr = source.getSymRef(tr);
+    SRef sort = translateSort(source.getSortRef(tr));
+    char const * name = source.getSymName(sr);
+    if (source.isConstant(sr)) {
+        return target.mkConst(sort, name);
+    }
+    if (source.isVar(sr)) {
+        return target.mkVar(sort, name, source.isInterpreted(sr));
+    }
+
+    vec<PTRef> args;
+    for (PTRef child : source.getPterm(tr)) {
+        assert(termCache.find(child) != termCache.end());
+        args.push(termCache.at(child));
+    }
+    if (source.isUF(sr)) {
+        return target.insertTerm(translateUFSymbol(sr), std::move(args));
+    }
+    return target.resolveTerm(name, std::move(args), sort);
+}
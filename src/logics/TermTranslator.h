@@ -0,0 +1,35 @@
+#ifndef OPENSMT_TERMTRANSLATOR_H
+#define OPENSMT_TERMTRANSLATOR_H
+
+#include "Logic.h"
+
+#include <unordered_map>
+
+/**
+ * Copies terms from one logic to another logic of the same type.
+ *
+ * Sorts, variables and uninterpreted functions missing in the target are declared on the fly, interpreted symbols are
+ * resolved by name.  Translations are cached, so translating many formulas sharing subterms is linear in the size of
+ * the shared DAG.  The two logics must not be modified concurrently while translating.
+ */
+class TermTranslator {
+    Logic const & source;
+    Logic & target;
+    std::unordered_map<PTRef, PTRef, PTRefHash> termCache;
+    std::unordered_map<SRef, SRef, SRefHash> sortCache;
+
+    class TranslationConfig;
+    PTRef translateNode(PTRef tr); // The children of tr must already be translated
+
+public:
+    TermTranslator(Logic const & source, Logic & target);
+
+    PTRef translate(PTRef tr);
+    SRef translateSort(SRef sr);
+    SymRef translateUFSymbol(SymRef sr);
+
+    Logic const & getSource() const { return source; }
+    Logic & getTarget() { return target; }
+};
+
+#endif //OPENSMT_TERMTRANSLATOR_H
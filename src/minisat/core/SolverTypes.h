@@ -142,7 +142,8 @@ class Clause {
         unsigned has_extra : 1;
         unsigned reloced   : 1;
         unsigned glue      : 3;
-        unsigned size      : 24; }                            header;
+        unsigned used      : 1;  // Used in conflict analysis since the last reduction of the learnt clauses
+        unsigned size      : 23; }                            header;
     union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
 
     friend class ClauseAllocator;
@@ -154,8 +155,10 @@ class Clause {
         header.learnt    = learnt;
         header.has_extra = use_extra;
         header.reloced   = 0;
+        assert(static_cast<unsigned>(ps.size()) < (1u << 23));
         header.size      = ps.size();
         header.glue      = 7;
+        header.used      = learnt;
 
         for (unsigned i = 0; i < (unsigned)ps.size(); i++)
             data[i].lit = ps[i];
@@ -208,6 +211,8 @@ public:
         assert(glue < 8);
         header.glue = glue;
     }
+    bool         used        () const        { return header.used; }
+    void         setUsed     (bool b)        { header.used = b; }
 };
 
 
@@ -273,6 +278,7 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
         // Copy extra data-fields:
         // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
         to[cr].mark(c.mark());
+        to[cr].setUsed(c.used());
         if (to[cr].learnt())         to[cr].activity() = c.activity();
         else if (to[cr].has_extra()) to[cr].calcAbstraction();
     }
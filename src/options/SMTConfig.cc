@@ -413,12 +413,85 @@ bool SMTConfig::setOption(const char* name, const SMTOption& value, const char*&
                 strcmp(val, spts_decisions) != 0)
         { msg = s_err_unknown_units; return false; }
     }
+    if (strcmp(name, o_sat_decision_heuristic) == 0) {
+        if (value.getValue().type != O_STR) { msg = s_err_not_str; return false; }
+        const char* val = value.getValue().strval;
+        if (strcmp(val, dheurs_vsids) != 0 &&
+                strcmp(val, dheurs_vmtf) != 0 &&
+                strcmp(val, dheurs_chb) != 0)
+        { msg = s_err_unknown_heuristic; return false; }
+    }
+    if (strcmp(name, o_sat_restart_strategy) == 0) {
+        if (value.getValue().type != O_STR) { msg = s_err_not_str; return false; }
+        const char* val = value.getValue().strval;
+        if (strcmp(val, rstrats_schedule) != 0 &&
+                strcmp(val, rstrats_dynamic) != 0 &&
+                strcmp(val, rstrats_alternating) != 0)
+        { msg = s_err_unknown_restarts; return false; }
+    }
     if (optionTable.has(name))
         optionTable.remove(name);
     insertOption(name, new SMTOption(value));
     return true;
 }
 
+void SMTConfig::copyOptionsFrom(SMTConfig const & other) {
+    for (int i = 0; i < other.option_names.size(); i++) {
+        const char* name = other.option_names[i];
+        insertOption(name, new SMTOption(*other.optionTable[name]));
+    }
+    // The parameters that are not options; the output channels and the status are not copied
+    print_stats                    = other.print_stats;
+    print_proofs_smtlib2           = other.print_proofs_smtlib2;
+    print_proofs_dotty             = other.print_proofs_dotty;
+    dump_formula                   = other.dump_formula;
+    certification_level            = other.certification_level;
+    strcpy(certifying_solver, other.certifying_solver);
+    sat_theory_polarity_suggestion = other.sat_theory_polarity_suggestion;
+    sat_initial_skip_step          = other.sat_initial_skip_step;
+    sat_skip_step_factor           = other.sat_skip_step_factor;
+    sat_use_luby_restart           = other.sat_use_luby_restart;
+    sat_learn_up_to_size           = other.sat_learn_up_to_size;
+    sat_temporary_learn            = other.sat_temporary_learn;
+    sat_preprocess_booleans        = other.sat_preprocess_booleans;
+    sat_preprocess_theory          = other.sat_preprocess_theory;
+    sat_centrality                 = other.sat_centrality;
+    sat_trade_off                  = other.sat_trade_off;
+    sat_minimize_conflicts         = other.sat_minimize_conflicts;
+    sat_dump_cnf                   = other.sat_dump_cnf;
+    sat_lazy_dtc                   = other.sat_lazy_dtc;
+    sat_lazy_dtc_burst             = other.sat_lazy_dtc_burst;
+    sat_reduce_proof               = other.sat_reduce_proof;
+    sat_reorder_pivots             = other.sat_reorder_pivots;
+    sat_ratio_red_time_solv_time   = other.sat_ratio_red_time_solv_time;
+    sat_red_time                   = other.sat_red_time;
+    sat_num_glob_trans_loops       = other.sat_num_glob_trans_loops;
+    sat_remove_mixed               = other.sat_remove_mixed;
+    sat_propagate_small            = other.sat_propagate_small;
+    sat_restart_learnt_thresh      = other.sat_restart_learnt_thresh;
+    sat_orig_thresh                = other.sat_orig_thresh;
+    proof_ratio_red_solv           = other.proof_ratio_red_solv;
+    proof_red_time                 = other.proof_red_time;
+    proof_reorder_pivots           = other.proof_reorder_pivots;
+    proof_reduce_while_reordering  = other.proof_reduce_while_reordering;
+    proof_random_context_analysis  = other.proof_random_context_analysis;
+    proof_random_swap_application  = other.proof_random_swap_application;
+    proof_remove_mixed             = other.proof_remove_mixed;
+    proof_certify_inter            = other.proof_certify_inter;
+    proof_random_seed              = other.proof_random_seed;
+    proof_switch_to_rp_hash        = other.proof_switch_to_rp_hash;
+    proof_trans_strength           = other.proof_trans_strength;
+    uf_disable                     = other.uf_disable;
+    cuf_bitwidth                   = other.cuf_bitwidth;
+    bv_disable                     = other.bv_disable;
+    dl_disable                     = other.dl_disable;
+    lra_disable                    = other.lra_disable;
+    lra_poly_deduct_size           = other.lra_poly_deduct_size;
+    lra_trade_off                  = other.lra_trade_off;
+    lra_integer_solver             = other.lra_integer_solver;
+    lra_check_on_assert            = other.lra_check_on_assert;
+}
+
 const SMTOption& SMTConfig::getOption(const char* name) const {
     if (optionTable.has(name))
         return *optionTable[name];
@@ -468,6 +541,10 @@ const char* SMTConfig::o_sat_dump_rnd_inter = ":sat-num-rnd-itps";
 const char* SMTConfig::o_garbage_frac  = ":garbage-frac";
 const char* SMTConfig::o_restart_first = ":restart-first";
 const char* SMTConfig::o_restart_inc   = ":restart-inc";
+const char* SMTConfig::o_sat_chrono_backtrack = ":chrono-backtrack";
+const char* SMTConfig::o_sat_decision_heuristic = ":decision-heuristic";
+const char* SMTConfig::o_sat_restart_strategy = ":restart-strategy";
+const char* SMTConfig::o_sat_rephase_interval = ":rephase-interval";
 const char* SMTConfig::o_produce_proofs = ":produce-proofs";
 const char* SMTConfig::o_produce_inter = ":produce-interpolants";
 const char* SMTConfig::o_certify_inter = ":certify-interpolants";
@@ -487,6 +564,9 @@ const char* SMTConfig::o_itp_bool_alg = ":interpolation-bool-algorithm";
 const char* SMTConfig::o_itp_euf_alg = ":interpolation-euf-algorithm";
 const char* SMTConfig::o_itp_lra_alg = ":interpolation-lra-algorithm";
 const char* SMTConfig::o_itp_lra_factor = ":interpolation-lra-factor";
+const char* SMTConfig::o_lra_float_simplex = ":lra-float-simplex";
+const char* SMTConfig::o_lia_gomory_cuts = ":lia-gomory-cuts";
+const char* SMTConfig::o_lra_relax_conflicts = ":lra-relax-conflicts";
 const char* SMTConfig::o_sat_resource_units = ":resource-units";
 const char* SMTConfig::o_sat_resource_limit = ":resource-limit";
 const char* SMTConfig::o_dump_state = ":dump-state";
@@ -531,6 +611,8 @@ const char* SMTConfig::s_err_not_num = "expected number";
 const char* SMTConfig::s_err_seed_zero = "seed cannot be 0";
 const char* SMTConfig::s_err_unknown_split = "unknown split type";
 const char* SMTConfig::s_err_unknown_units = "unknown split units";
+const char* SMTConfig::s_err_unknown_heuristic = "unknown decision heuristic";
+const char* SMTConfig::s_err_unknown_restarts = "unknown restart strategy";
 
 void
 SMTConfig::initializeConfig( )
@@ -572,7 +654,7 @@ SMTConfig::initializeConfig( )
   dl_disable                    = 0;
   // LRA-Solver Default configuration
   lra_disable                   = 0;
-  lra_poly_deduct_size          = 0;
+  lra_poly_deduct_size          = 5;
   lra_integer_solver            = 0;
   lra_check_on_assert           = 0;
   // Proof parameters
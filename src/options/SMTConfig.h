@@ -189,6 +189,14 @@ static const char* const spts_none      = "none";
 static const char* const spts_decisions = "decisions";
 static const char* const spts_time      = "time";
 
+static const char* const rstrats_schedule    = "schedule";
+static const char* const rstrats_dynamic     = "dynamic";
+static const char* const rstrats_alternating = "alternating";
+
+static const char* const dheurs_vsids   = "vsids";
+static const char* const dheurs_vmtf    = "vmtf";
+static const char* const dheurs_chb     = "chb";
+
 static const char* const spprefs_tterm   = "tterm";
 static const char* const spprefs_blind   = "blind";
 static const char* const spprefs_bterm   = "bterm";
@@ -203,6 +211,10 @@ static const struct SpType spt_scatter   = { 2 };
 
 enum class SpUnit : char { decisions, time };
 
+enum class DecisionHeuristicType : char { vsids, vmtf, chb };
+
+enum class RestartStrategy : char { schedule, dynamic, alternating };
+
 static const struct SpPref sppref_tterm = { 0 };
 static const struct SpPref sppref_blind = { 1 };
 static const struct SpPref sppref_bterm = { 2 };
@@ -250,6 +262,14 @@ public:
   static const char* o_garbage_frac;
   static const char* o_restart_first;
   static const char* o_restart_inc;
+  // Backtrack chronologically if the backjump would undo more decision levels than this.  Negative means never.
+  static const char* o_sat_chrono_backtrack;
+  // The variable order used for decisions: vsids (default), vmtf or chb
+  static const char* o_sat_decision_heuristic;
+  // When to restart: schedule (Luby or geometric, default), dynamic (glue averages) or alternating between the two
+  static const char* o_sat_restart_strategy;
+  // Conflicts before the first rephasing; the interval grows arithmetically.  Zero disables rephasing.
+  static const char* o_sat_rephase_interval;
   static const char* o_produce_proofs;
   static const char* o_produce_inter;
   static const char* o_certify_inter;
@@ -269,6 +289,12 @@ public:
   static const char* o_itp_euf_alg;
   static const char* o_itp_lra_alg;
   static const char* o_itp_lra_factor;
+  // Search for a feasible basis in floating point before the exact Simplex check.  Nonzero enables.
+  static const char* o_lra_float_simplex;
+  // The number of Gomory cuts added in one check of the integer solver.  Zero, the default, disables the cuts.
+  static const char* o_lia_gomory_cuts;
+  // The largest conflict of the linear arithmetic solver whose bounds are replaced by weaker ones.  Zero disables.
+  static const char* o_lra_relax_conflicts;
   static const char* o_sat_dump_rnd_inter;
   static const char* o_sat_resource_units;
   static const char* o_sat_resource_limit;
@@ -312,6 +338,8 @@ private:
   static const char* s_err_seed_zero;
   static const char* s_err_unknown_split;
   static const char* s_err_unknown_units;
+  static const char* s_err_unknown_heuristic;
+  static const char* s_err_unknown_restarts;
 
 
   Info          info_Empty;
@@ -419,6 +447,8 @@ public:
 
   void setUsedForInitiliazation() { usedForInitialization = true; }
 
+  void copyOptionsFrom(SMTConfig const & other); // Copies all options and parameters of other; used to derive configurations of parallel workers
+
   inline bool produceProof( ) {
       return optionTable.has(o_produce_proofs) ? optionTable[o_produce_proofs]->getValue().numval > 0 : false;
   }
@@ -559,6 +589,40 @@ public:
   double sat_restart_inc() const
     { return optionTable.has(o_restart_inc) ?
         optionTable[o_restart_inc]->getValue().numval : 1.1; }
+  bool lra_float_simplex() const
+    { return optionTable.has(o_lra_float_simplex) and optionTable[o_lra_float_simplex]->getValue().numval != 0; }
+  int lia_gomory_cuts() const
+    { return optionTable.has(o_lia_gomory_cuts) ?
+        optionTable[o_lia_gomory_cuts]->getValue().numval : 0; }
+  int lra_relax_conflicts() const
+    { return optionTable.has(o_lra_relax_conflicts) ?
+        optionTable[o_lra_relax_conflicts]->getValue().numval : 0; }
+  int sat_chrono_backtrack() const
+    { return optionTable.has(o_sat_chrono_backtrack) ?
+        optionTable[o_sat_chrono_backtrack]->getValue().numval : -1; }
+  DecisionHeuristicType sat_decision_heuristic() const {
+      if (optionTable.has(o_sat_decision_heuristic)) {
+          const char* type = optionTable[o_sat_decision_heuristic]->getValue().strval;
+          if (strcmp(type, dheurs_vmtf) == 0)
+              return DecisionHeuristicType::vmtf;
+          else if (strcmp(type, dheurs_chb) == 0)
+              return DecisionHeuristicType::chb;
+      }
+      return DecisionHeuristicType::vsids;
+  }
+  int sat_rephase_interval() const
+    { return optionTable.has(o_sat_rephase_interval) ?
+        optionTable[o_sat_rephase_interval]->getValue().numval : 0; }
+  RestartStrategy sat_restart_strategy() const {
+      if (optionTable.has(o_sat_restart_strategy)) {
+          const char* type = optionTable[o_sat_restart_strategy]->getValue().strval;
+          if (strcmp(type, rstrats_dynamic) == 0)
+              return RestartStrategy::dynamic;
+          else if (strcmp(type, rstrats_alternating) == 0)
+              return RestartStrategy::alternating;
+      }
+      return RestartStrategy::schedule;
+  }
   int proof_interpolant_cnf() const
   { return optionTable.has(o_interpolant_cnf) ?
       optionTable[o_interpolant_cnf]->getValue().numval : 0; }
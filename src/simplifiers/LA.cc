@@ -160,26 +160,23 @@ opensmt::pair<PTRef, PTRef> LAExpression::getSubst() {
     }
     // There is at least one variable
     // Solve w.r.t. first variable
-    solve();
+    PTRef var = solve();
+    return getSubst(var);
+}
+
+opensmt::pair<PTRef, PTRef> LAExpression::getSubst(PTRef var) {
+    solve(var);
     vec<PTRef> sum_list;
     opensmt::Real constant = 0;
-    PTRef var = PTRef_Undef;
-    SRef polySort = SRef_Undef;
+    SRef polySort = logic.getSortRef(var);
     for (auto const & [v, factor] : polynome) {
         if (v == PTRef_Undef) {
             constant = - factor;
-        } else {
-            polySort = polySort != SRef_Undef ? polySort : logic.getSortRef(v);
-            if (var == PTRef_Undef) {
-                var = v;
-                assert(factor == 1);
-            } else {
-                PTRef c =  logic.mkConst(polySort, - factor);
-                sum_list.push(logic.mkTimes(c, v));
-            }
+        } else if (v != var) {
+            PTRef c =  logic.mkConst(polySort, - factor);
+            sum_list.push(logic.mkTimes(c, v));
         }
     }
-    assert(polySort != SRef_Undef);
     sum_list.push(logic.mkConst(polySort, constant));
     PTRef poly = logic.mkPlus(sum_list);
     return {var, poly};
@@ -208,7 +205,14 @@ PTRef LAExpression::solve() {
     auto it = polynome.begin();
     if (it->first == PTRef_Undef) it++;
     PTRef var = it->first;
-    const opensmt::Real coeff = it->second;
+    solve(var);
+    return var;
+}
+
+void LAExpression::solve(PTRef var) {
+    assert(r == OP::EQ);
+    assert(polynome.find(var) != polynome.end());
+    const opensmt::Real coeff = polynome[var];
     //
     // Divide polynome by coeff
     //
@@ -216,7 +220,6 @@ PTRef LAExpression::solve() {
         term.second /= coeff;
     }
     assert(polynome[var] == 1);
-    return var;
 }
 
 //
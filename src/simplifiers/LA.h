@@ -61,12 +61,20 @@ public:
 
     void initialize(PTRef, bool canonize = true);      // Initialize
     PTRef solve();           // Solve w.r.t. some variable
+    void solve(PTRef var);   // Solve w.r.t. the given variable
     void canonize();           // Canonize (different from solve!)
     PTRef toPTRef(SRef sort) const;
 
     void print(std::ostream &) const;
 
     opensmt::pair<PTRef, PTRef> getSubst();    // Get a valid substitution
+    opensmt::pair<PTRef, PTRef> getSubst(PTRef var);    // Get the substitution for the given variable
+
+    // The coefficient of the variable, zero if it does not occur
+    opensmt::Real getCoeff(PTRef var) const {
+        auto it = polynome.find(var);
+        return it == polynome.end() ? opensmt::Real(0) : it->second;
+    }
 
     // Adds an expression to the current one multiplied by Real
     void addExprWithCoeff(const LAExpression &, const opensmt::Real &);
@@ -0,0 +1,38 @@
+#include "ClauseChannel.h"
+
+#include "OsmtApiException.h"
+
+ClauseChannel::ClauseChannel(unsigned int numberOfParticipants, uint64_t capacity)
+    : lanes(numberOfParticipants)
+    , capacity(capacity)
+{
+    if (capacity == 0) { throw OsmtApiException("Clause channel needs a positive capacity"); }
+    for (Lane & lane : lanes) {
+        lane.slots = std::make_unique<Slot[]>(capacity);
+    }
+}
+
+ClauseChannel::Endpoint::Endpoint(ClauseChannel & channel, unsigned int participant)
+    : channel(channel)
+    , participant(participant)
+    , cursors(channel.lanes.size(), 0)
+{
+    if (participant >= channel.lanes.size()) { throw OsmtApiException("No such participant in the clause channel"); }
+    // Clauses published before the endpoint was created are still received
+}
+
+bool ClauseChannel::Endpoint::publish(vec<Lit> const & clause) {
+    if (clause.size() == 0 or clause.size() > static_cast<int>(maxClauseSize)) { return false; }
+    Lane & lane = channel.lanes[participant];
+    uint64_t position = lane.head.load(std::memory_order_relaxed); // Only this endpoint writes to the lane
+    Slot & slot = lane.slots[position % channel.capacity];
+    slot.sequence.store(writing, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.size.store(clause.size(), std::memory_order_relaxed);
+    for (int i = 0; i < clause.size(); i++) {
+        slot.lits[i].store(toInt(clause[i]), std::memory_order_relaxed);
+    }
+    slot.sequence.store(position + 1, std::memory_order_release);
+    lane.head.store(position + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef OPENSMT_CLAUSECHANNEL_H
+#define OPENSMT_CLAUSECHANNEL_H
+
+#include "SolverTypes.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * A lock-free, bounded channel through which SAT solvers running in different threads exchange short clauses.
+ *
+ * Every participant owns a lane, a ring buffer to which only the participant publishes and from which all other
+ * participants read.  Publishing never blocks: when a lane is full the oldest clauses are overwritten, and readers
+ * that fall behind simply miss them.  A reader detects a slot that is overwritten while it is being read from the
+ * sequence number of the slot, and drops the clause.
+ *
+ * The channel stores literals as they are numbered by the publisher; it is up to the participants to agree on the
+ * meaning of the variables (see CoreSMTSolver::connectClauseChannel).
+ */
+class ClauseChannel {
+public:
+    static constexpr unsigned maxClauseSize = 8;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0}; // Position + 1 of the clause stored in the slot, or writing while it is written
+        std::atomic<uint32_t> size{0};
+        std::array<std::atomic<int>, maxClauseSize> lits;
+    };
+
+    struct Lane {
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<uint64_t> head{0};    // Number of clauses ever published to the lane
+    };
+
+    static constexpr uint64_t writing = UINT64_MAX;
+
+    std::vector<Lane> lanes;
+    uint64_t const capacity;
+
+public:
+    ClauseChannel(unsigned int numberOfParticipants, uint64_t capacity = 1u << 12);
+
+    /**
+     * The view of the channel of a single participant.  An endpoint must be used by one thread at a time.
+     */
+    class Endpoint {
+        ClauseChannel & channel;
+        unsigned int participant;
+        std::vector<uint64_t> cursors;    // Position of the next unread clause in each lane
+        vec<Lit> received;
+    public:
+        Endpoint(ClauseChannel & channel, unsigned int participant);
+
+        // Returns false if the clause is too long to be shared
+        bool publish(vec<Lit> const & clause);
+
+        // Calls consume(vec<Lit> const &) for every clause published by the other participants since the last call
+        template<typename F>
+        void receive(F && consume);
+    };
+
+    unsigned int getNumberOfParticipants() const { return lanes.size(); }
+};
+
+template<typename F>
+void ClauseChannel::Endpoint::receive(F && consume) {
+    for (unsigned int lane = 0; lane < channel.lanes.size(); lane++) {
+        if (lane == participant) { continue; }
+        Lane const & source = channel.lanes[lane];
+        uint64_t head = source.head.load(std::memory_order_acquire);
+        uint64_t & cursor = cursors[lane];
+        if (head - cursor > channel.capacity) {
+            cursor = head - channel.capacity; // The older clauses have been overwritten
+        }
+        for (; cursor < head; cursor++) {
+            Slot const & slot = source.slots[cursor % channel.capacity];
+            if (slot.sequence.load(std::memory_order_acquire) != cursor + 1) { continue; }
+            uint32_t size = slot.size.load(std::memory_order_relaxed);
+            received.clear();
+            for (uint32_t i = 0; i < size and i < maxClauseSize; i++) {
+                received.push(toLit(slot.lits[i].load(std::memory_order_relaxed)));
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != cursor + 1) { continue; } // Overwritten while reading
+            consume(static_cast<vec<Lit> const &>(received));
+        }
+    }
+}
+
+#endif //OPENSMT_CLAUSECHANNEL_H
@@ -47,6 +47,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "CoreSMTSolver.h"
 
 #include "ModelBuilder.h"
+#include "OsmtApiException.h"
 #include "OsmtInternalException.h"
 #include "Sort.h"
 
@@ -76,7 +77,6 @@ CoreSMTSolver::CoreSMTSolver(SMTConfig & c, THandler& t )
     , init             (false)
     , stop             (false)
     // Parameters: (formerly in 'SearchParams')
-    , var_decay        (c.sat_var_decay())
     , clause_decay     (c.sat_clause_decay())
     , random_var_freq  (c.sat_random_var_freq())
     , luby_restart     (c.sat_luby_restart())
@@ -86,6 +86,9 @@ CoreSMTSolver::CoreSMTSolver(SMTConfig & c, THandler& t )
     , garbage_frac     (c.sat_garbage_frac())
     , restart_first    (c.sat_restart_first())
     , restart_inc      (c.sat_restart_inc())
+    , chrono_backtrack (c.sat_chrono_backtrack())
+    , restart_strategy (c.sat_restart_strategy())
+    , rephase_interval (c.sat_rephase_interval())
     , learntsize_factor((double)1/(double)3)
     , learntsize_inc   ( 1.1 )
       // More parameters:
@@ -100,17 +103,25 @@ CoreSMTSolver::CoreSMTSolver(SMTConfig & c, THandler& t )
     , learnts_size(0) , all_learnts(0)
     , learnt_theory_conflicts(0)
     , top_level_lits        (0)
+    , exported_clauses      (0)
+    , imported_clauses      (0)
+    , chrono_backtracks     (0)
+    , conflict_implications (0)
+    , dynamic_restarts      (0)
+    , blocked_restarts      (0)
+    , restart_phases        (0)
+    , rephases              (0)
 
     , ok                    (true)
     , conflict_frame        (0)
     , n_clauses             (0)
     , cla_inc               (1)
-    , var_inc               (1)
     , watches               (WatcherDeleted(ca))
+    , watchesBin            (WatcherDeleted(ca))
     , qhead                 (0)
     , simpDB_assigns        (-1)
     , simpDB_props          (0)
-    , order_heap            (VarOrderLt(activity))
+    , decisionHeuristic     (DecisionHeuristic::create(assigns, c))
     , random_seed           (c.getRandomSeed())
     , progress_estimate     (0)
     , remove_satisfied      (true)
@@ -139,6 +150,10 @@ CoreSMTSolver::initialize( )
     random_seed = config.getRandomSeed();
     restart_first = config.sat_restart_first();
     restart_inc = config.sat_restart_inc();
+    chrono_backtrack = config.sat_chrono_backtrack();
+    restart_strategy = config.sat_restart_strategy();
+    rephase_interval = config.sat_rephase_interval();
+    next_rephase = conflicts + static_cast<uint64_t>(std::max(0, rephase_interval)) * (rephases + 1);
     // Set some parameters
     skip_step = config.sat_initial_skip_step;
     skipped_calls = 0;
@@ -205,20 +220,23 @@ Var CoreSMTSolver::newVar(bool dvar)
     int v = nVars();
     watches  .init(mkLit(v, false));
     watches  .init(mkLit(v, true));
+    watchesBin.init(mkLit(v, false));
+    watchesBin.init(mkLit(v, true));
     assigns  .push(l_Undef);
     vardata  .push(mkVarData(CRef_Undef, 0));
-    activity .push(rnd_init_act ? opensmt::drand(random_seed) * 0.00001 : 0);
+    decisionHeuristic->newVar(v, rnd_init_act ? opensmt::drand(random_seed) * 0.00001 : 0);
     seen     .push(0);
     decision .push();
     trail    .capacity(v+1);
     setDecisionVar(v, dvar);
     savedPolarity.push(true);
+    bestPolarity.push(true);
 
     this->var_seen.push(false);
 
     // MB: Unnecessary call to insertVarOrder. This is already achieved by calling setDecisionVar above
     // insertVarOrder(v);
-    assert(!decision[v] || order_heap.inHeap(v));
+    assert(!decision[v] || decisionHeuristic->inQueue(v));
 
 
     // Added Lines
@@ -320,8 +338,9 @@ void CoreSMTSolver::attachClause(CRef cr)
 {
     const Clause& c = ca[cr];
     assert(c.size() > 1);
-    watches[~c[0]].push(Watcher(cr, c[1]));
-    watches[~c[1]].push(Watcher(cr, c[0]));
+    auto & ws = c.size() == 2 ? watchesBin : watches;
+    ws[~c[0]].push(Watcher(cr, c[1]));
+    ws[~c[1]].push(Watcher(cr, c[0]));
     if (c.learnt()) learnts_literals += c.size();
     else            clauses_literals += c.size();
 }
@@ -330,16 +349,17 @@ void CoreSMTSolver::detachClause(CRef cr, bool strict)
 {
     const Clause& c = ca[cr];
     assert(c.size() > 1);
+    auto & ws = c.size() == 2 ? watchesBin : watches;
     if (strict)
     {
-        remove(watches[~c[0]], Watcher(cr, c[1]));
-        remove(watches[~c[1]], Watcher(cr, c[0]));
+        remove(ws[~c[0]], Watcher(cr, c[1]));
+        remove(ws[~c[1]], Watcher(cr, c[0]));
     }
     else
     {
         // Lazy detaching: (NOTE! Must clean all watcher lists before garbage collecting this clause)
-        watches.smudge(~c[0]);
-        watches.smudge(~c[1]);
+        ws.smudge(~c[0]);
+        ws.smudge(~c[1]);
     }
 
     if (c.learnt()) learnts_literals -= c.size();
@@ -349,9 +369,12 @@ void CoreSMTSolver::detachClause(CRef cr, bool strict)
 void CoreSMTSolver::removeClause(CRef cr)
 {
     Clause& c = ca[cr];
+    if (c.learnt()) learnts_in_tier[static_cast<int>(learntTier(c))]--;
     detachClause(cr);
-    // Don't leave pointers to free'd memory!
-    if (locked(c)) vardata[var(c[0])].reason = CRef_Undef;
+    // Don't leave pointers to free'd memory!  The implied literal of a binary clause can be in either position
+    for (unsigned i = 0; i < (c.size() == 2 ? 2u : 1u); i++) {
+        if (value(c[i]) == l_True && reason(var(c[i])) == cr) vardata[var(c[i])].reason = CRef_Undef;
+    }
     c.mark(1);
     if (logsProofForInterpolation()) {
         // Remove clause and derivations if ref becomes 0
@@ -363,6 +386,21 @@ void CoreSMTSolver::removeClause(CRef cr)
     }
 }
 
+void CoreSMTSolver::addLearnt(CRef cr)
+{
+    learnts.push(cr);
+    Clause const & c = ca[cr];
+    if (c.learnt()) learnts_in_tier[static_cast<int>(learntTier(c))]++;
+}
+
+void CoreSMTSolver::setLearntGlue(Clause& c, uint32_t glue)
+{
+    assert(c.learnt());
+    learnts_in_tier[static_cast<int>(learntTier(c))]--;
+    c.setGlue(glue);
+    learnts_in_tier[static_cast<int>(learntTier(c))]++;
+}
+
 bool CoreSMTSolver::satisfied(const Clause& c) const
 {
     for (unsigned i = 0; i < c.size(); i++)
@@ -378,28 +416,95 @@ void CoreSMTSolver::cancelUntil(int level)
 {
     if (decisionLevel() > level)
     {
-        if (trail.size() > longestTrail) {
-            for (auto p : trail) {
-                savedPolarity[var(p)] = not sign(p);
-            }
-            longestTrail = trail.size();
-        }
+        savePhases();
+        int kept = 0;
         for (int c = trail.size()-1; c >= trail_lim[level]; c--)
         {
             Var      x  = var(trail[c]);
 #ifdef PEDANTIC_DEBUG
             assert(assigns[x] != l_Undef);
 #endif
+            if (vardata[x].level <= level) {
+                // Implied out of order after chronological backtracking; stays assigned
+                kept++;
+                continue;
+            }
             assigns [x] = l_Undef;
             insertVarOrder(x);
         }
         qhead = trail_lim[level];
-        trail.shrink(trail.size() - trail_lim[level]);
+        int j = trail_lim[level];
+        if (kept > 0) {
+            for (int c = trail_lim[level]; c < trail.size(); c++) {
+                if (vardata[var(trail[c])].level <= level) {
+                    trail[j++] = trail[c];
+                }
+            }
+        }
+        trail.shrink(trail.size() - j);
         trail_lim.shrink(trail_lim.size() - level);
 
         //if ( first_model_found )
-        theory_handler.backtrack(trail.size());
+        theory_handler.backtrack(qhead);
+        // The kept literals are asserted again to the theory at the next check
+    }
+}
+
+int CoreSMTSolver::backtrackTarget(int backjump_level)
+{
+    // Learnt units are always asserted at level 0
+    if (not chronoBacktracking() or backjump_level == 0 or decisionLevel() - backjump_level <= std::max(1, chrono_backtrack)) {
+        return backjump_level;
     }
+    chrono_backtracks++;
+    return decisionLevel() - 1;
+}
+
+int CoreSMTSolver::conflictLevel(CRef confl) const
+{
+    Clause const & c = ca[confl];
+    int max = 0;
+    for (unsigned i = 0; i < c.size(); i++) {
+        max = std::max(max, level(var(c[i])));
+    }
+    return max;
+}
+
+/*
+ * With chronological backtracking a conflict can have a single literal on the highest level of its literals.  The
+ * conflict is then the clause analyze would learn; instead of learning a duplicate, the solver backtracks one level and
+ * implies the literal by the conflict at the highest level of the other literals.
+ */
+bool CoreSMTSolver::impliedByConflict(CRef confl)
+{
+    Clause & c = ca[confl];
+    int const conflLevel = decisionLevel();
+    unsigned implied = c.size();
+    unsigned second = c.size();
+    for (unsigned i = 0; i < c.size(); i++) {
+        int lev = level(var(c[i]));
+        if (lev == conflLevel) {
+            if (implied != c.size()) { return false; }
+            implied = i;
+        } else if (second == c.size() or lev > level(var(c[second]))) {
+            second = i;
+        }
+    }
+    assert(implied != c.size() and second != c.size());
+    int const impliedLevel = level(var(c[second]));
+    cancelUntil(conflLevel - 1);
+    // The implied literal goes first and the literal of the highest level is watched with it
+    if (c.size() == 2) {
+        impliedFirst(c, c[implied]);
+    } else if (implied != 0 or second != 1) {
+        detachClause(confl, true);
+        std::swap(c[0], c[implied]);
+        std::swap(c[1], c[second == 0 ? implied : second]);
+        attachClause(confl);
+    }
+    conflict_implications++;
+    uncheckedEnqueue(c[0], confl, impliedLevel);
+    return true;
 }
 
 void CoreSMTSolver::printClause(Clause & cl) {
@@ -416,9 +521,14 @@ void CoreSMTSolver::printClause(CRef cref) {
 void CoreSMTSolver::cancelUntilVar( Var v )
 {
     int c;
+    vec<Lit> kept; // Literals implied at lower levels out of order; they do not depend on v
     for ( c = trail.size( )-1 ; var(trail[ c ]) != v ; c -- )
     {
         Var     x    = var(trail[ c ]);
+        if (level(x) < level(v)) {
+            kept.push(trail[c]);
+            continue;
+        }
         assigns[ x ] = l_Undef;
         insertVarOrder( x );
     }
@@ -428,7 +538,6 @@ void CoreSMTSolver::cancelUntilVar( Var v )
     insertVarOrder( v );
 
     trail.shrink(trail.size( ) - c );
-    qhead = trail.size( );
 
     if ( decisionLevel( ) > level(v) )
     {
@@ -444,6 +553,10 @@ void CoreSMTSolver::cancelUntilVar( Var v )
     }
 
     theory_handler.backtrack(trail.size());
+    for (int i = kept.size() - 1; i >= 0; i--) {
+        trail.push(kept[i]);
+    }
+    qhead = trail.size( );
 }
 
 void CoreSMTSolver::cancelUntilVarTempInit( Var v )
@@ -513,7 +626,7 @@ void CoreSMTSolver::cancelUntilVarTempDone( )
 Var CoreSMTSolver::doRandomDecision() {
     Var next = var_Undef;
     if (branchLitRandom()) {
-        next = order_heap[opensmt::irand(random_seed,order_heap.size())];
+        next = decisionHeuristic->randomCandidate(random_seed);
         if (value(next) == l_Undef && decision[next])
             rnd_decisions++;
     }
@@ -521,17 +634,17 @@ Var CoreSMTSolver::doRandomDecision() {
 }
 
 bool CoreSMTSolver::branchLitRandom() {
-    return opensmt::drand(random_seed) < random_var_freq && !order_heap.empty();
+    return opensmt::drand(random_seed) < random_var_freq && !decisionHeuristic->empty();
 }
 
 Var CoreSMTSolver::doActivityDecision() {
     Var next = var_Undef;
     while (next == var_Undef || value(next) != l_Undef || !decision[next]) {
-        if (order_heap.empty()) {
+        if (decisionHeuristic->empty()) {
             next = var_Undef;
             break;
         } else {
-            next = order_heap.removeMin();
+            next = decisionHeuristic->removeBest();
         }
     }
     return next;
@@ -548,7 +661,7 @@ Lit CoreSMTSolver::choosePolarity(Var next) {
             return mkLit(next, sign);
         }
     }
-    sign = (savedPolarity[next] == flipState);
+    sign = not savedPolarity[next];
     return mkLit(next, sign);
 }
 
@@ -616,11 +729,15 @@ void CoreSMTSolver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
     {
         assert(confl != CRef_Undef); // (otherwise should be UIP)
         Clause& c = ca[confl];
+        if (p != lit_Undef) {
+            impliedFirst(c, p);
+        }
 
         if (c.learnt()) {
             claBumpActivity(c);
+            c.setUsed(true);
             const uint32_t newGlue = computeGlue(c);
-            if (newGlue < c.getGlue()) c.setGlue(newGlue);
+            if (newGlue < c.getGlue()) setLearntGlue(c, newGlue);
         }
 
         for (unsigned j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++)
@@ -648,11 +765,11 @@ void CoreSMTSolver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
                 }
             }
         }
-        // Select next clause to look at:
-        while (!seen[var(trail[index--])])
-            ; // Do nothing
+        // Select next clause to look at; after chronological backtracking literals of lower levels may be interleaved
+        while (!seen[var(trail[index])] or level(var(trail[index])) < decisionLevel())
+            index--;
         assert(index >= 0);
-        p = trail[index+1];
+        p = trail[index--];
 
         if (reason(var(p)) == CRef_Fake)
         {
@@ -684,7 +801,7 @@ void CoreSMTSolver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
             else
             {
                 ctr = config.sat_temporary_learn ? ca.alloc(r, {true, computeGlue(r)}) : ca.alloc(r);
-                learnts.push(ctr);
+                addLearnt(ctr);
                 attachClause(ctr);
                 undo_stack.push(undo_stack_el(undo_stack_el::NEWLEARNT, ctr));
                 claBumpActivity(ca[ctr]);
@@ -862,7 +979,7 @@ bool CoreSMTSolver::litRedundant(Lit p, uint32_t abstract_levels)
             else
             {
                 ct = config.sat_temporary_learn ? ca.alloc(r, {true, computeGlue(r)}) : ca.alloc(r);
-                learnts.push(ct);
+                addLearnt(ct);
                 if (config.isIncremental() != 0)
                     undo_stack.push(undo_stack_el(undo_stack_el::NEWLEARNT, ct));
                 attachClause(ct);
@@ -888,6 +1005,7 @@ bool CoreSMTSolver::litRedundant(Lit p, uint32_t abstract_levels)
         }
 
         Clause& c = ca[cr];
+        impliedFirst(c, ~analyze_stack.last());
 
         analyze_stack.pop();
 
@@ -996,6 +1114,7 @@ void CoreSMTSolver::analyzeFinal(Lit p, vec<Lit>& out_conflict)
                 else
                 {
                     Clause& c = ca[reason(x)];
+                    impliedFirst(c, trail[i]);
                     assert(c[0] == trail[i]);
                     for (unsigned j = 1; j < c.size(); j++) {
                         seen[var(c[j])] = 1;
@@ -1018,11 +1137,17 @@ void CoreSMTSolver::analyzeFinal(Lit p, vec<Lit>& out_conflict)
 
 
 void CoreSMTSolver::uncheckedEnqueue(Lit p, CRef from)
+{
+    uncheckedEnqueue(p, from, decisionLevel());
+}
+
+void CoreSMTSolver::uncheckedEnqueue(Lit p, CRef from, int level)
 {
     assert(from != CRef_Fake || theory_handler.getLogic().isTheoryTerm(theory_handler.varToTerm(var(p))));
     assert(value(p) == l_Undef);
+    assert(level <= decisionLevel());
     assigns[var(p)] = lbool(!sign(p));
-    vardata[var(p)] = mkVarData(from, decisionLevel());
+    vardata[var(p)] = mkVarData(from, level);
     trail.push(p);
 }
 
@@ -1043,6 +1168,8 @@ CRef CoreSMTSolver::propagate()
     CRef    confl     = CRef_Undef;
     int     num_props = 0;
     watches.cleanAll();
+    watchesBin.cleanAll();
+    bool const chrono = chronoBacktracking();
 
     while (qhead < trail.size())
     {
@@ -1050,6 +1177,42 @@ CRef CoreSMTSolver::propagate()
         vec<Watcher>&  ws  = watches[p];
         Watcher        *i, *j, *end;
         num_props++;
+        decisionHeuristic->propagated(var(p));
+
+        // Binary clauses first, without inspecting the clause:
+        for (Watcher const & w : watchesBin[p])
+        {
+            Lit other = w.blocker;
+            lbool otherValue = value(other);
+            if (otherValue == l_True) {
+                continue;
+            }
+            if (otherValue == l_False) {
+                confl = w.cref;
+                if (decisionLevel() == 0 && this->logsProofForInterpolation()) {
+                    this->finalizeProof(confl);
+                }
+                break;
+            }
+            CRef cr = w.cref;
+            if (decisionLevel() == 0 && this->logsProofForInterpolation()) {
+                // As below for longer clauses: log the derivation of the unit clause at level 0
+                assert(reason(var(p)) != CRef_Fake && reason(var(p)) != CRef_Undef);
+                proof->beginChain(cr);
+                proof->addResolutionStep(reason(var(p)), var(p));
+                cr = ca.alloc(vec<Lit>{other});
+                proof->endChain(cr);
+            }
+            if (chrono) {
+                uncheckedEnqueue(other, cr, level(var(p)));
+            } else {
+                uncheckedEnqueue(other, cr);
+            }
+        }
+        if (confl != CRef_Undef) {
+            qhead = trail.size();
+            break;
+        }
 
         for (i = j = (Watcher*)ws, end = i + ws.size();  i != end;)
         {
@@ -1122,7 +1285,11 @@ CRef CoreSMTSolver::propagate()
                     // Necessary for correct functioning of proof logging in analyze()
                     cr = unitClause;
                 }
-                uncheckedEnqueue(first, cr);
+                if (chrono) {
+                    uncheckedEnqueue(first, cr, impliedLevel(c));
+                } else {
+                    uncheckedEnqueue(first, cr);
+                }
             }
 
 NextClause:
@@ -1142,7 +1309,9 @@ NextClause:
   |  reduceDB : ()  ->  [void]
   |
   |  Description:
-  |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
+  |    Reduce the learnt clauses tier by tier.  Core clauses are kept.  Mid tier clauses not used in
+  |    conflict analysis since the previous reduction are demoted to the local tier.  The less active
+  |    half of the local tier is removed, minus the clauses locked by the current assignment. Locked
   |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
   |________________________________________________________________________________________________@*/
 struct reduceDB_lt
@@ -1158,24 +1327,39 @@ void CoreSMTSolver::reduceDB()
 {
     int     i, j;
 
-    sort(learnts, reduceDB_lt(ca));
-    // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
-    // and clauses with high glue score
-    int extra = 0;
+    vec<CRef> local;
     for (i = j = 0; i < learnts.size(); i++)
     {
         Clause& c = ca[learnts[i]];
-        if (c.getGlue() <= 3) {
-            extra++;
+        switch (learntTier(c)) {
+            case LearntTier::Core:
+                learnts[j++] = learnts[i];
+                break;
+            case LearntTier::Mid:
+                if (not c.used()) {
+                    setLearntGlue(c, midTierGlue + 1); // Reduced by activity from the next reduction on
+                }
+                c.setUsed(false);
+                learnts[j++] = learnts[i];
+                break;
+            case LearntTier::Local:
+                local.push(learnts[i]);
+                break;
         }
-        if (c.getGlue() > 3 and not locked(c) and (i+extra < learnts.size() / 2)) {
-            assert(c.size() > 2);
-            removeClause(learnts[i]);
+    }
+    learnts.shrink(i - j);
+
+    sort(local, reduceDB_lt(ca));
+    // Don't delete binary or locked clauses. From the rest, delete clauses from the less active half
+    for (i = 0; i < local.size(); i++)
+    {
+        Clause& c = ca[local[i]];
+        if (c.size() > 2 and not locked(c) and i < local.size() / 2) {
+            removeClause(local[i]);
         } else {
-            learnts[j++] = learnts[i];
+            learnts.push(local[i]);
         }
     }
-    learnts.shrink(i - j);
     checkGarbage();
     if (logsProofForInterpolation()) {
         // Remove unused leaves
@@ -1210,7 +1394,7 @@ void CoreSMTSolver::rebuildOrderHeap()
     for (Var v = 0; v < nVars(); v++)
         if (decision[v] && value(v) == l_Undef)
             vs.push(v);
-    order_heap.build(vs);
+    decisionHeuristic->rebuild(vs);
 }
 
 
@@ -1239,7 +1423,7 @@ bool CoreSMTSolver::simplify()
         removeSatisfied(clauses);
     checkGarbage();
     // rebuildOrderHeap();
-    order_heap.filter(VarFilter(*this));
+    decisionHeuristic->filter([this](Var v) { return value(v) == l_Undef && decision[v]; });
 
     simpDB_assigns = nAssigns();
     simpDB_props   = clauses_literals + learnts_literals;   // (shouldn't depend on stats really, but it will do for now)
@@ -1294,16 +1478,17 @@ void CoreSMTSolver::popBacktrackPoint()
             const Var x = op.getVar();
 
             // Undoes insertVarOrder( )
-            assert( order_heap.inHeap(x) );
-            order_heap  .remove(x);
+            assert( decisionHeuristic->inQueue(x) );
+            decisionHeuristic->popVar(x);
             // Undoes decision_var ... watches
             decision    .pop();
             seen        .pop();
-            activity    .pop();
             vardata     .pop();
             assigns     .pop();
             watches.clean(mkLit(x, true));
             watches.clean(mkLit(x, false));
+            watchesBin.clean(mkLit(x, true));
+            watchesBin.clean(mkLit(x, false));
             // Remove variable from translation tables
 //      theory_handler->clearVar( x );
         }
@@ -1344,9 +1529,9 @@ void CoreSMTSolver::popBacktrackPoint()
     assert( isOK( ) );
 }
 
-bool CoreSMTSolver::okContinue() const
+bool CoreSMTSolver::okContinue()
 {
-    return not opensmt::stop;
+    return not opensmt::stop and not stop;
 }
 
 void CoreSMTSolver::learntSizeAdjust() {
@@ -1429,10 +1614,6 @@ lbool CoreSMTSolver::search(int nof_conflicts)
 
         CRef confl = propagate();
         if (confl != CRef_Undef) {
-            if (conflicts > conflictsUntilFlip) {
-                flipState = not flipState;
-                conflictsUntilFlip += flipState ? flipIncrement / 10 : flipIncrement;
-            }
             // CONFLICT
             if (verbosity and conflicts % 1000 == 999) {
                 uint64_t units = trail_lim.size() == 0 ?  trail.size() :  trail_lim[0];
@@ -1445,13 +1626,22 @@ lbool CoreSMTSolver::search(int nof_conflicts)
 
             conflicts++;
             conflictC++;
+            blockRestart();
+            if (chronoBacktracking()) {
+                // Literals implied out of order can make the conflict appear above its own level
+                cancelUntil(conflictLevel(confl));
+                if (decisionLevel() > 0 and impliedByConflict(confl)) {
+                    continue;
+                }
+            }
             if (decisionLevel() == 0) {
                 return zeroLevelConflictHandler();
             }
             learnt_clause.clear();
             analyze(confl, learnt_clause, backtrack_level);
 
-            cancelUntil(backtrack_level);
+            int const asserting_level = backtrack_level;
+            cancelUntil(backtrackTarget(backtrack_level));
 
             assert(value(learnt_clause[0]) == l_Undef);
 
@@ -1463,20 +1653,25 @@ lbool CoreSMTSolver::search(int nof_conflicts)
                     reason = cr;
                 }
                 uncheckedEnqueue(learnt_clause[0], reason);
+                exportClause(learnt_clause, 1);
+                updateGlueAverages(1);
             } else {
                 // ADDED FOR NEW MINIMIZATION
                 learnts_size += learnt_clause.size( );
                 all_learnts ++;
 
-                CRef cr = ca.alloc(learnt_clause, {true, computeGlue(learnt_clause)});
+                uint32_t glue = computeGlue(learnt_clause);
+                exportClause(learnt_clause, glue);
+                updateGlueAverages(glue);
+                CRef cr = ca.alloc(learnt_clause, {true, glue});
 
                 if (logsProofForInterpolation()) {
                     proof->endChain(cr);
                 }
-                learnts.push(cr);
+                addLearnt(cr);
                 attachClause(cr);
                 claBumpActivity(ca[cr]);
-                uncheckedEnqueue(learnt_clause[0], cr);
+                uncheckedEnqueue(learnt_clause[0], cr, asserting_level);
             }
 
             varDecayActivity();
@@ -1485,12 +1680,19 @@ lbool CoreSMTSolver::search(int nof_conflicts)
             learntSizeAdjust();
         } else {
             // NO CONFLICT
-            if ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || !withinBudget()) {
+            if ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || !withinBudget() || rephaseDue()) {
                 // Reached bound on number of conflicts:
                 progress_estimate = progressEstimate();
                 cancelUntil(0);
                 return l_Undef;
             }
+            if (dynamicRestartDue()) {
+                dynamic_restarts++;
+                restart_postponed_until = conflicts + restartMinimumInterval;
+                progress_estimate = progressEstimate();
+                cancelUntil(0);
+                return l_Undef;
+            }
 
             // Simplify the set of problem clauses:
             if (decisionLevel() == 0 && !simplify()) {
@@ -1735,7 +1937,17 @@ lbool CoreSMTSolver::solve_()
 
     if (config.dryrun())
         stop = true;
+    // Variables created by the theories during the search are numbered differently in each participant
+    int const termMapperVars = theory_handler.getTMap().nVars();
+    shared_vars = std::min(shared_vars_limit, termMapperVars);
     while (status == l_Undef && !opensmt::stop && !this->stop) {
+        if (not importClauses()) {
+            status = zeroLevelConflictHandler();
+            break;
+        }
+        if (rephaseDue()) {
+            rephase();
+        }
         // Print some information. At every restart for
         // standard mode or any 2^n intervarls for luby
         // restarts
@@ -1753,12 +1965,22 @@ lbool CoreSMTSolver::solve_()
             next_printout *= restart_inc;
         }
 
-        // XXX
-        status = search((int)nof_conflicts);
-        nof_conflicts = restartNextLimit(nof_conflicts);
+        if (dynamicRestarts()) {
+            // The glue averages decide the restarts; with the alternating strategy the search ends with the phase
+            int phaseConflicts = restart_strategy == RestartStrategy::alternating ? static_cast<int>(phase_end - std::min(phase_end, conflicts)) : -1;
+            status = search(phaseConflicts);
+        } else {
+            status = search((int)nof_conflicts);
+            nof_conflicts = restartNextLimit(nof_conflicts);
+        }
+        updateRestartPhase();
+    }
+    if (theory_handler.getTMap().nVars() > termMapperVars) {
+        shared_vars_limit = std::min(shared_vars_limit, termMapperVars);
     }
 
     if (status == l_True) {
+        model_phase = current_phase;
         // Extend & copy model:
         model.growTo(nVars());
         for (int i = 0; i < nVars(); i++) {
@@ -1785,6 +2007,79 @@ lbool CoreSMTSolver::zeroLevelConflictHandler() {
     return l_False;
 }
 
+//=================================================================================================
+// Clause sharing:
+
+/*
+ * The participants must have the same numbering of the variables they share.  This holds for solvers that have been
+ * given the same formulas in the same order, such as the workers of PortfolioSolver: the variables created by the term
+ * mappers outside the search are the same.  Variables created during the search, for instance by theory splits, are
+ * never shared, and neither are the variables created after them.
+ */
+void CoreSMTSolver::connectClauseChannel(ClauseChannel & channel, unsigned int participant, uint32_t maxGlue) {
+    if (logsProofForInterpolation()) { throw OsmtApiException("Clause sharing is not supported with interpolation"); }
+    clauseChannel = std::make_unique<ClauseChannel::Endpoint>(channel, participant);
+    share_glue_limit = maxGlue;
+}
+
+void CoreSMTSolver::disconnectClauseChannel() {
+    clauseChannel.reset();
+}
+
+bool CoreSMTSolver::isShareable(Var v) const {
+    return v < shared_vars and v < var_seen.size() and var_seen[v] and decision[v];
+}
+
+void CoreSMTSolver::exportClause(vec<Lit> const & c, uint32_t glue) {
+    if (not clauseChannel or glue > share_glue_limit or c.size() > static_cast<int>(ClauseChannel::maxClauseSize)) { return; }
+    for (Lit l : c) {
+        if (not isShareable(var(l))) { return; }
+    }
+    if (clauseChannel->publish(c)) { exported_clauses++; }
+}
+
+/*
+ * Called at decision level 0, at the beginning of a restart.  The literals false at level 0 are dropped from the
+ * imported clauses, so that the remaining ones can be watched.
+ */
+bool CoreSMTSolver::importClauses() {
+    if (not clauseChannel) { return true; }
+    assert(decisionLevel() == 0);
+    bool consistent = true;
+    vec<Lit> ps;
+    clauseChannel->receive([&](vec<Lit> const & c) {
+        if (not consistent) { return; }
+        ps.clear();
+        for (Lit l : c) {
+            if (not isShareable(var(l))) { return; }
+            if (value(l) == l_True) { return; }
+            if (value(l) == l_Undef) { ps.push(l); }
+        }
+        sort(ps);
+        Lit prev = lit_Undef;
+        int j = 0;
+        for (Lit l : ps) {
+            if (l == ~prev) { return; }
+            if (l != prev) { ps[j++] = prev = l; }
+        }
+        ps.shrink(ps.size() - j);
+        imported_clauses++;
+        if (ps.size() == 0) {
+            consistent = false;
+        } else if (ps.size() == 1) {
+            uncheckedEnqueue(ps[0]);
+            consistent = propagate() == CRef_Undef;
+        } else {
+            // The levels of the exporter are not known; the clause starts in the mid tier, where it is demoted unless
+            // conflict analysis uses it and lowers its glue
+            CRef cr = ca.alloc(ps, {true, midTierGlue});
+            addLearnt(cr);
+            attachClause(cr);
+        }
+    });
+    return consistent;
+}
+
 
 //=================================================================================================
 // Garbage Collection methods:
@@ -1795,6 +2090,7 @@ void CoreSMTSolver::relocAll(ClauseAllocator& to)
     //
     // for (int i = 0; i < watches.size(); i++)
     watches.cleanAll();
+    watchesBin.cleanAll();
     for (int v = 0; v < nVars(); v++)
         for (int s = 0; s < 2; s++)
         {
@@ -1803,6 +2099,9 @@ void CoreSMTSolver::relocAll(ClauseAllocator& to)
             vec<Watcher>& ws = watches[p];
             for (int j = 0; j < ws.size(); j++)
                 ca.reloc(ws[j].cref, to);
+            vec<Watcher>& wsBin = watchesBin[p];
+            for (int j = 0; j < wsBin.size(); j++)
+                ca.reloc(wsBin[j].cref, to);
         }
 
     // All reasons:
@@ -1855,6 +2154,111 @@ void CoreSMTSolver::setAssumptions(vec<Lit> const & assumps) {
     }
 }
 
+const char* CoreSMTSolver::phaseName(Phase phase)
+{
+    switch (phase) {
+        case Phase::Original: return "original";
+        case Phase::Inverted: return "inverted";
+        case Phase::Best: return "best";
+        case Phase::Random: return "random";
+        case Phase::Theory: return "theory";
+    }
+    return "unknown";
+}
+
+void CoreSMTSolver::savePhases()
+{
+    if (trail.size() > longestTrail) {
+        for (auto p : trail) {
+            savedPolarity[var(p)] = not sign(p);
+        }
+        longestTrail = trail.size();
+    }
+    if (trail.size() > bestTrail) {
+        for (auto p : trail) {
+            bestPolarity[var(p)] = not sign(p);
+        }
+        bestTrail = trail.size();
+    }
+}
+
+bool CoreSMTSolver::rephaseDue() const
+{
+    return rephase_interval > 0 and conflicts >= next_rephase;
+}
+
+void CoreSMTSolver::rephase()
+{
+    assert(decisionLevel() == 0);
+    current_phase = rephaseCycle[rephases % (sizeof(rephaseCycle) / sizeof(rephaseCycle[0]))];
+    rephases++;
+    switch (current_phase) {
+        case Phase::Original:
+            for (int v = 0; v < nVars(); v++) { savedPolarity[v] = true; }
+            break;
+        case Phase::Inverted:
+            for (int v = 0; v < nVars(); v++) { savedPolarity[v] = false; }
+            break;
+        case Phase::Best:
+            for (int v = 0; v < nVars(); v++) { savedPolarity[v] = bestPolarity[v]; }
+            bestTrail = 0;
+            break;
+        case Phase::Random:
+            for (int v = 0; v < nVars(); v++) { savedPolarity[v] = opensmt::drand(random_seed) < 0.5; }
+            break;
+        case Phase::Theory:
+            for (int v = 0; v < nVars(); v++) {
+                if (not theory_handler.isDeclared(v)) { continue; }
+                lbool suggestion = theory_handler.getSolverHandler().getPolaritySuggestion(theory_handler.varToTerm(v));
+                if (suggestion != l_Undef) { savedPolarity[v] = suggestion == l_True; }
+            }
+            break;
+    }
+    // The target phase is searched for anew from the reset polarities
+    longestTrail = 0;
+    next_rephase = conflicts + static_cast<uint64_t>(rephase_interval) * (rephases + 1);
+}
+
+bool CoreSMTSolver::dynamicRestarts() const
+{
+    return restart_strategy == RestartStrategy::dynamic or (restart_strategy == RestartStrategy::alternating and not stable_phase);
+}
+
+void CoreSMTSolver::blockRestart()
+{
+    if (restart_strategy == RestartStrategy::schedule) { return; }
+    if (conflicts > restartBlockingStart and trail.size() > restartBlockingMargin * trail_average.value()
+        and conflicts >= restart_postponed_until) {
+        blocked_restarts++;
+        restart_postponed_until = conflicts + restartMinimumInterval;
+    }
+    trail_average.update(trail.size());
+}
+
+void CoreSMTSolver::updateGlueAverages(uint32_t glue)
+{
+    if (restart_strategy == RestartStrategy::schedule) { return; }
+    fast_glue.update(glue);
+    slow_glue.update(glue);
+}
+
+bool CoreSMTSolver::dynamicRestartDue() const
+{
+    return dynamicRestarts() and conflicts >= restart_postponed_until and decisionLevel() > assumptions.size()
+           and fast_glue.value() > restartMargin * slow_glue.value();
+}
+
+void CoreSMTSolver::updateRestartPhase()
+{
+    if (restart_strategy != RestartStrategy::alternating or conflicts < phase_end) { return; }
+    if (stable_phase) {
+        phase_length *= 2;
+    }
+    stable_phase = not stable_phase;
+    phase_end = conflicts + phase_length;
+    restart_phases++;
+}
+
 int CoreSMTSolver::restartNextLimit ( int nof_conflicts )
 {
     // Luby's restart
@@ -1890,6 +2294,26 @@ void CoreSMTSolver::printStatistics( ostream & os )
     os << "; T-conflicts learnt.......: " << learnt_theory_conflicts << endl;
     os << "; Average learnts size.....: " << learnts_size/conflicts << endl;
     os << "; Top level literals.......: " << top_level_lits << endl;
+    os << "; Core learnts.............: " << nLearnts(LearntTier::Core) << endl;
+    os << "; Mid tier learnts.........: " << nLearnts(LearntTier::Mid) << endl;
+    os << "; Local learnts............: " << nLearnts(LearntTier::Local) << endl;
+    if (clauseChannel) {
+        os << "; Clauses exported.........: " << exported_clauses << endl;
+        os << "; Clauses imported.........: " << imported_clauses << endl;
+    }
+    if (chrono_backtrack >= 0) {
+        os << "; Chronological backtracks.: " << chrono_backtracks << endl;
+        os << "; Implied by conflicts.....: " << conflict_implications << endl;
+    }
+    if (rephases > 0) {
+        os << "; Rephases.................: " << rephases << endl;
+        os << "; Phase of the last model..: " << phaseName(model_phase) << endl;
+    }
+    if (restart_strategy != RestartStrategy::schedule) {
+        os << "; Dynamic restarts.........: " << dynamic_restarts << endl;
+        os << "; Blocked restarts.........: " << blocked_restarts << endl;
+        os << "; Restart phase switches...: " << restart_phases << endl;
+    }
     os << "; Search time..............: " << search_timer.getTime() << " s" << endl;
     if ( config.sat_preprocess_booleans != 0
             || config.sat_preprocess_theory != 0 )
@@ -48,6 +48,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "THandler.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <iosfwd>
 #include <memory>
@@ -60,6 +62,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "Alg.h"
 
 #include "SolverTypes.h"
+#include "ClauseChannel.h"
+#include "DecisionHeuristic.h"
 
 #include "Timer.h"
 
@@ -73,6 +77,25 @@ std::ostream& operator <<(std::ostream& out, Lit l); // MB: Feel free to find a
 template<class A, class B>
 struct Pair { A first; B second; };
 
+// An exponential moving average.  The smoothing factor starts from 1 and halves at exponentially growing intervals
+// until it reaches alpha, so that the first values are not biased towards the initial zero.
+class ExponentialMovingAverage {
+    double   average = 0;
+    double   alpha;
+    double   beta = 1;
+    uint64_t wait = 0;
+    uint64_t period = 0;
+public:
+    explicit ExponentialMovingAverage(double alpha) : alpha(alpha) {}
+    void update(double value) {
+        average += beta * (value - average);
+        if (beta <= alpha or wait-- > 0) { return; }
+        wait = period = 2 * (period + 1) - 1;
+        beta = std::max(alpha, beta / 2);
+    }
+    double value() const { return average; }
+};
+
 
 
 //=================================================================================================
@@ -89,7 +112,21 @@ protected:
     bool      init;
     enum class ConsistencyAction { BacktrackToZero, ReturnUndef, SkipToSearchBegin, NoOp };
 public:
-    bool stop = false;
+    std::atomic<bool> stop = false; // Can be set from another thread to interrupt the search
+
+    // The learnt clauses are divided into tiers by their glue.  Core clauses are kept forever, mid tier clauses as long
+    // as they keep being used in conflict analysis, and local clauses are reduced by activity.
+    enum class LearntTier { Core, Mid, Local };
+    static constexpr uint32_t coreTierGlue = 2;     // Highest glue of a core clause
+    static constexpr uint32_t midTierGlue = 6;      // Highest glue of a mid tier clause
+    static LearntTier learntTier(Clause const & c) {
+        return c.getGlue() <= coreTierGlue ? LearntTier::Core : c.getGlue() <= midTierGlue ? LearntTier::Mid : LearntTier::Local;
+    }
+
+    // The phases the saved polarities are periodically reset to.  Between the resets the solver follows the target
+    // phase, the phase of the longest trail since the last reset.
+    enum class Phase { Original, Inverted, Best, Random, Theory };
+    static const char* phaseName(Phase phase);
 
     // Constructor/Destructor:
     //
@@ -146,11 +183,17 @@ public:
     int     nAssigns   ()      const;       // The current number of assigned literals.
     int     nClauses   ()      const;       // The current number of original clauses.
     int     nLearnts   ()      const;       // The current number of learnt clauses.
+    int     nLearnts   (LearntTier tier) const; // The current number of learnt clauses in the given tier.
     int     nVars      ()      const;       // The current number of variables.
     int     nFreeVars  ()      const;
 
     void fillBooleanVars(ModelBuilder & modelBuilder);
 
+    // Clause sharing:
+    //
+    void connectClauseChannel(ClauseChannel & channel, unsigned int participant, uint32_t maxGlue = 2); // Exchange clauses with the other participants of the channel
+    void disconnectClauseChannel();
+
     Proof const & getProof() const { assert(proof); return *proof; }
 
     // Resource contraints:
@@ -192,7 +235,6 @@ public:
 
     // Mode of operation:
     //
-    double    var_decay;          // Inverse of the variable activity decay factor.                                            (default 1 / 0.95)
     double    clause_decay;       // Inverse of the clause activity decay factor.                                              (1 / 0.999)
     double    random_var_freq;    // The frequency with which the decision heuristic tries to choose a random variable.        (default 0.02)
     bool      luby_restart;
@@ -203,6 +245,9 @@ public:
     double    garbage_frac;       // The fraction of wasted memory allowed before a garbage collection is triggered.
     int       restart_first;      // The initial restart limit.                                                                (default 100)
     double    restart_inc;        // The factor with which the restart limit is multiplied in each restart.                    (default 1.1)
+    int       chrono_backtrack;   // Backtrack chronologically if a backjump would undo more levels than this (-1=never).        (default -1)
+    RestartStrategy restart_strategy; // Restart on a schedule, on the glue averages, or alternate between the two.             (default schedule)
+    int       rephase_interval;   // The conflicts before the first rephasing, growing arithmetically (0=never).              (default 0)
     double    learntsize_factor;  // The intitial limit for learnt clauses is a factor of the original clauses.                (default 1 / 3)
     double    learntsize_inc;     // The limit for learnt clauses is multiplied with this factor each restart.                 (default 1.1)
     bool      expensive_ccmin;    // Controls conflict clause minimization.                                                    (default TRUE)
@@ -222,6 +267,13 @@ public:
     uint64_t all_learnts;
     uint64_t learnt_theory_conflicts;
     uint64_t top_level_lits;
+    uint64_t exported_clauses, imported_clauses;
+    uint64_t chrono_backtracks;
+    uint64_t conflict_implications;
+    uint64_t dynamic_restarts, blocked_restarts, restart_phases;
+    uint64_t rephases;
+    Phase    current_phase = Phase::Original; // The last phase the polarities were reset to
+    Phase    model_phase = Phase::Original;   // The value of current_phase when the last model was found
 
 
 protected:
@@ -280,21 +332,6 @@ protected:
         }
     };
 
-    struct VarOrderLt
-    {
-        const vec<double>&  activity;
-        bool operator () (Var x, Var y) const { return activity[x] > activity[y]; }
-        VarOrderLt(const vec<double>&  act) : activity(act) { }
-    };
-
-    friend class VarFilter;
-    struct VarFilter
-    {
-        const CoreSMTSolver& s;
-        VarFilter(const CoreSMTSolver& _s) : s(_s) {}
-        bool operator()(Var v) const { return s.assigns[v] == l_Undef && s.decision[v]; }
-    };
-
 
     // Solver state:
     //
@@ -303,21 +340,20 @@ protected:
     uint32_t            n_clauses;        // number of clauses in the problem
     vec<CRef>           clauses;          // List of problem clauses.
     vec<CRef>           learnts;          // List of learnt clauses.
+    int                 learnts_in_tier[3] = {0, 0, 0}; // Number of clauses of learnts with the learnt flag in each tier
     vec<CRef>           tmp_reas;         // Reasons for minimize_conflicts 2
 #ifdef PEDANTIC_DEBUG
     vec<Clause*>        debug_reasons;    // Reasons for the theory deduced clauses
     Map<Var,int,VarHash> debug_reason_map; // Maps the deduced lit to the clause used to deduce it
 #endif
     double              cla_inc;          // Amount to bump next clause with.
-    vec<double>         activity;         // A heuristic measurement of the activity of a variable.
-    double              var_inc;          // Amount to bump next variable with.
     OccLists<Lit, vec<Watcher>, WatcherDeleted>  watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    OccLists<Lit, vec<Watcher>, WatcherDeleted>  watchesBin;       // As 'watches', but for binary clauses; the blocker is the other literal of the clause.
     vec<lbool>          assigns;          // The current assignments (lbool:s stored as char:s).
-    vec<bool>           savedPolarity;
-    int                 longestTrail = 0;
-    uint64_t            conflictsUntilFlip = 0;
-    uint64_t            flipIncrement = 10000;
-    bool                flipState = false;
+    vec<bool>           savedPolarity;    // The phase used for decisions: the target phase, or the phase set by the last rephasing
+    int                 longestTrail = 0; // Length of the trail of the target phase since the last rephasing
+    vec<bool>           bestPolarity;     // The phase of the longest trail since best phase was last used
+    int                 bestTrail = 0;
     vec<bool>           var_seen;
     vec<char>           decision;         // Declares if a variable is eligible for selection in the decision heuristic.
 protected:
@@ -336,7 +372,7 @@ protected:
     int64_t             simpDB_props;     // Remaining number of propagations that must be made before next execution of 'simplify()'.
     vec<Lit>            assumptions;      // Current set of assumptions provided to solve by the user.
     Map<Var,int, VarHash> assumptions_order; // Defined for active assumption variables: how manyeth active assumption variable this is in assumptions
-    Heap<VarOrderLt>    order_heap;       // A priority queue of variables ordered with respect to the variable activity.
+    std::unique_ptr<DecisionHeuristic> decisionHeuristic; // The order of the variables for decisions (see SMTConfig::o_sat_decision_heuristic).
     double              random_seed;      // Used by the random variable selection.
     double              progress_estimate;// Set by 'search()'.
     bool                remove_satisfied; // Indicates whether possibly inefficient linear scan for satisfied clauses should be performed in 'simplify'.
@@ -355,6 +391,11 @@ protected:
     double              learntsize_adjust_confl;
     int                 learntsize_adjust_cnt;
     int                 unadvised_splits; // How many times the split happened on a PTRef that the logic considers ill-advised
+
+    std::unique_ptr<ClauseChannel::Endpoint> clauseChannel; // If set, low-glue learnts and units are exchanged through the channel
+    uint32_t            share_glue_limit = 2;                 // Learnts with glue at most this are exported
+    int                 shared_vars_limit = std::numeric_limits<int>::max(); // Variables below this are numbered the same way by the term mappers of all participants
+    int                 shared_vars = 0;                      // Variables that can be shared in the current search
     // Resource contraints:
     //
     int64_t             conflict_budget;    // -1 means no budget.
@@ -372,9 +413,14 @@ protected:
     virtual Lit  pickBranchLit ();                                                     // Return the next decision variable.
     virtual void newDecisionLevel ();                                                  // Begins a new decision level.
     void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef);                         // Enqueue a literal. Assumes value of literal is undefined.
+    void     uncheckedEnqueue (Lit p, CRef from, int level);                           // Enqueue a literal implied at a given level.
     bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
     CRef     propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
     virtual void cancelUntil  (int level);                                             // Backtrack until a certain level.
+    bool     chronoBacktracking() const;                                               // Are literals implied at their own level and backtracking chronological
+    int      backtrackTarget  (int backjump_level);                                    // The level to which to backtrack after learning a clause asserting at backjump_level
+    int      conflictLevel    (CRef confl) const;                                      // The highest level of the literals of the conflict
+    bool     impliedByConflict(CRef confl);                                            // Backtrack and imply the only literal of the conflict on the current level, if there is one
     void     analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
     template<class T>
     uint32_t computeGlue(T const & ps);
@@ -384,7 +430,7 @@ protected:
     lbool    search           (int nof_conflicts);                    // Search for a given number of conflicts.
     int nof_learnts = 40000;
     double nofLearntsIncrement = 1.1;
-    virtual bool okContinue   () const;                                                // Check search termination conditions
+    virtual bool okContinue   ();                                                      // Check search termination conditions
     virtual ConsistencyAction notifyConsistency() { return ConsistencyAction::NoOp; }  // Called when the search has reached a consistent point
     virtual void notifyEnd() { }                                                       // Called at the end of the search loop
     void     learntSizeAdjust ();                                                      // Adjust learnts size and print something
@@ -392,11 +438,13 @@ protected:
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
     void     rebuildOrderHeap ();
     virtual lbool zeroLevelConflictHandler();                                          // Common handling of zero-level conflict as it can happen at multiple places
+    bool     isShareable      (Var v) const;                                           // Can clauses on v be exchanged with other solvers
+    void     exportClause     (vec<Lit> const & c, uint32_t glue);                     // Publish a learnt clause to the clause channel if it is good enough
+    bool     importClauses    ();                                                      // Add the clauses published by other solvers.  Returns false on conflict
 
     // Maintaining Variable/Clause activity:
     //
     void     varDecayActivity ();                      // Decay all variables with the specified factor. Implemented by increasing the 'bump' value instead.
-    void     varBumpActivity  (Var v, double inc);     // Increase a variable with the current 'bump' value.
     void     varBumpActivity  (Var v);                 // Increase a variable with the current 'bump' value.
 
     // Added Line
@@ -411,7 +459,11 @@ protected:
     virtual void attachClause     (CRef cr);               // Attach a clause to watcher lists.
     virtual void detachClause     (CRef cr, bool strict = false); // Detach a clause to watcher lists.
     void     removeClause     (CRef c);             // Detach and free a clause.
+    void     addLearnt        (CRef cr);            // Add a clause to the learnts and count it in its tier.
+    void     setLearntGlue    (Clause& c, uint32_t glue); // Change the glue of a learnt clause of learnts, moving it between the tiers.
     bool     locked           (const Clause& c) const; // Returns TRUE if a clause is a reason for some implication in the current state.
+    void     impliedFirst     (Clause& c, Lit implied); // Moves the implied literal of a reason to the front.  Binary clauses are propagated without reordering them.
+    int      impliedLevel     (const Clause& c) const; // The highest level of the false literals of a clause that implies c[0].
     bool     satisfied        (const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
 
     void     relocAll         (ClauseAllocator& to);
@@ -479,6 +531,37 @@ protected:
     unsigned           luby_k;                     // Keep track of luby k
     std::vector<unsigned> luby_previous;           // Previously computed luby numbers
     unsigned           lubyFactor = 120;
+
+    // Dynamic restarts: restart when the glue of the recent learnt clauses is high compared to the long term average,
+    // unless the trail is unusually long, suggesting the solver is close to a model.  With the alternating strategy,
+    // focused phases with dynamic restarts alternate with stable phases using the restart schedule.
+    static constexpr double   restartMargin = 1.10;           // Restart if the fast glue average exceeds the slow one by this factor
+    static constexpr double   restartBlockingMargin = 1.4;    // Postpone restarts if the trail exceeds its average by this factor
+    static constexpr uint64_t restartBlockingStart = 10000;   // No blocking before this many conflicts
+    static constexpr uint64_t restartMinimumInterval = 50;    // Conflicts between restarts, and after blocking
+    static constexpr uint64_t initialPhaseLength = 1000;      // Conflicts in the first focused and stable phases
+    ExponentialMovingAverage fast_glue{1.0 / 32};
+    ExponentialMovingAverage slow_glue{1.0 / 16384};
+    ExponentialMovingAverage trail_average{1.0 / 4096};
+    uint64_t           restart_postponed_until = 0;   // No dynamic restart before this many conflicts
+    bool               stable_phase = false;
+    uint64_t           phase_length = initialPhaseLength;
+    uint64_t           phase_end = initialPhaseLength;
+
+    // Rephasing (see SMTConfig::o_sat_rephase_interval):
+    static constexpr Phase rephaseCycle[] = { Phase::Original, Phase::Best, Phase::Inverted, Phase::Best,
+                                              Phase::Random, Phase::Best, Phase::Theory, Phase::Best };
+    uint64_t           next_rephase = 0;     // The conflict count at which the polarities are reset next
+
+    void   savePhases             ( );             // Update the target and best phases from the trail before backtracking
+    bool   rephaseDue             ( ) const;       // Has the search reached the conflict count of the next rephasing
+    void   rephase                ( );             // Reset the saved polarities to the next phase of the cycle
+
+    bool   dynamicRestarts        ( ) const;       // Are restarts currently decided by the glue averages
+    void   blockRestart           ( );             // Called at a conflict before backtracking
+    void   updateGlueAverages     ( uint32_t );    // Called for each learnt clause
+    bool   dynamicRestartDue      ( ) const;
+    void   updateRestartPhase     ( );             // Switch between focused and stable phases
     bool               cuvti;                      // For cancelUntilVarTemp
     vec<Lit>           lit_to_restore;             // For cancelUntilVarTemp
     vec<lbool>         val_to_restore;             // For cancelUntilVarTemp
@@ -592,30 +675,16 @@ inline void CoreSMTSolver::printTrace() const
 
 inline void CoreSMTSolver::insertVarOrder(Var x)
 {
-    if (!order_heap.inHeap(x) && decision[x]) order_heap.insert(x);
+    if (decision[x]) decisionHeuristic->insert(x);
 }
 
 inline void CoreSMTSolver::varDecayActivity()
 {
-    var_inc *= var_decay;
+    decisionHeuristic->conflictDone();
 }
 inline void CoreSMTSolver::varBumpActivity(Var v)
 {
-    varBumpActivity(v, var_inc);
-}
-inline void CoreSMTSolver::varBumpActivity(Var v, double inc)
-{
-    if ( (activity[v] += inc) > 1e100 )
-    {
-        // Rescale:
-        for (int i = 0; i < nVars(); i++)
-            activity[i] *= 1e-100;
-        var_inc *= 1e-100;
-    }
-
-    // Update order_heap with respect to new activity:
-    if (order_heap.inHeap(v))
-        order_heap.decrease(v);
+    decisionHeuristic->bump(v);
 }
 
 //=================================================================================================
@@ -683,8 +752,30 @@ inline bool     CoreSMTSolver::addOriginalClause(Lit p, Lit q, Lit r)
 
 inline bool     CoreSMTSolver::locked          (const Clause& c) const
 {
-    return value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef && reason(var(c[0])) != CRef_Fake && ca.lea(reason(var(c[0]))) == &c;
+    auto isReason = [this, &c](Lit l) {
+        return value(l) == l_True && reason(var(l)) != CRef_Undef && reason(var(l)) != CRef_Fake && ca.lea(reason(var(l))) == &c;
+    };
+    // The implied literal of a binary clause can be in either position
+    return isReason(c[0]) || (c.size() == 2 && isReason(c[1]));
+}
+
+inline void     CoreSMTSolver::impliedFirst    (Clause& c, Lit implied)
+{
+    if (c.size() == 2 && c[0] != implied) {
+        assert(c[1] == implied);
+        c[1] = c[0];
+        c[0] = implied;
+    }
+}
+inline int      CoreSMTSolver::impliedLevel    (const Clause& c) const
+{
+    int max = 0;
+    for (unsigned i = 1; i < c.size(); i++) {
+        max = std::max(max, level(var(c[i])));
+    }
+    return max;
 }
+inline bool     CoreSMTSolver::chronoBacktracking() const { return chrono_backtrack >= 0 && !logsProofForInterpolation(); }
 #ifndef PEDANTIC_DEBUG
 inline void     CoreSMTSolver::newDecisionLevel()
 {
@@ -709,6 +800,7 @@ inline lbool    CoreSMTSolver::modelValue    (Lit p) const                { retu
 inline int      CoreSMTSolver::nAssigns      ()      const                { return trail.size(); }
 inline int      CoreSMTSolver::nClauses      ()      const                { return clauses.size(); }
 inline int      CoreSMTSolver::nLearnts      ()      const                { return learnts.size(); }
+inline int      CoreSMTSolver::nLearnts      (LearntTier tier) const  { return learnts_in_tier[static_cast<int>(tier)]; }
 inline int      CoreSMTSolver::nVars         ()      const                { return vardata.size(); }
 inline int      CoreSMTSolver::nFreeVars     ()      const                { return (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]); }
 inline void     CoreSMTSolver::setDecisionVar(Var v, bool b)
@@ -748,7 +840,7 @@ uint32_t CoreSMTSolver::computeGlue(T const & ps) {
         if (level != 0 and not levelsInClause.contains(level)) {
             levelsInClause.insert(level);
             ++ numLevels;
-            if (numLevels >= 4) {
+            if (numLevels > midTierGlue) {
                 break;
             }
         }
@@ -0,0 +1,152 @@
+#include "DecisionHeuristic.h"
+
+#include "Random.h"
+
+#include <algorithm>
+
+std::unique_ptr<DecisionHeuristic> DecisionHeuristic::create(vec<lbool> const & assigns, SMTConfig const & config) {
+    switch (config.sat_decision_heuristic()) {
+        case DecisionHeuristicType::vmtf:
+            return std::make_unique<VMTFHeuristic>(assigns);
+        case DecisionHeuristicType::chb:
+            return std::make_unique<CHBHeuristic>();
+        case DecisionHeuristicType::vsids:
+        default:
+            return std::make_unique<VSIDSHeuristic>(config);
+    }
+}
+
+void ScoreHeapHeuristic::newVar(Var v, double initialActivity) {
+    assert(v == score.size());
+    (void)v;
+    score.push(initialActivity);
+}
+
+void ScoreHeapHeuristic::popVar(Var v) {
+    assert(v == score.size() - 1);
+    if (order_heap.inHeap(v)) {
+        order_heap.remove(v);
+    }
+    score.pop();
+}
+
+void ScoreHeapHeuristic::insert(Var v) {
+    if (not order_heap.inHeap(v)) {
+        order_heap.insert(v);
+    }
+}
+
+Var ScoreHeapHeuristic::randomCandidate(double & seed) const {
+    assert(not order_heap.empty());
+    return order_heap[opensmt::irand(seed, order_heap.size())];
+}
+
+void VSIDSHeuristic::bump(Var v) {
+    if ((score[v] += var_inc) > 1e100) {
+        // Rescale:
+        for (int i = 0; i < score.size(); i++) {
+            score[i] *= 1e-100;
+        }
+        var_inc *= 1e-100;
+    }
+    // Update order_heap with respect to new activity:
+    if (order_heap.inHeap(v)) {
+        order_heap.decrease(v);
+    }
+}
+
+void CHBHeuristic::newVar(Var v, double initialActivity) {
+    ScoreHeapHeuristic::newVar(v, initialActivity);
+    lastConflict.push(0);
+}
+
+void CHBHeuristic::popVar(Var v) {
+    ScoreHeapHeuristic::popVar(v);
+    lastConflict.pop();
+}
+
+void CHBHeuristic::propagated(Var v) {
+    // The variables of the latest conflict have age one
+    uint64_t age = conflicts - lastConflict[v];
+    double multiplier = age <= 1 ? 1.0 : 0.9;
+    double reward = multiplier / static_cast<double>(std::max<uint64_t>(age, 1));
+    score[v] = (1 - stepSize) * score[v] + stepSize * reward;
+    if (order_heap.inHeap(v)) {
+        order_heap.update(v);
+    }
+}
+
+void CHBHeuristic::conflictDone() {
+    conflicts++;
+    stepSize = std::max(minimalStepSize, stepSize - stepSizeDecrement);
+}
+
+void VMTFHeuristic::unlink(Var v) {
+    if (prev[v] != var_Undef) { next[prev[v]] = next[v]; } else { first = next[v]; }
+    if (next[v] != var_Undef) { prev[next[v]] = prev[v]; } else { last = prev[v]; }
+    prev[v] = next[v] = var_Undef;
+}
+
+void VMTFHeuristic::append(Var v) {
+    prev[v] = last;
+    next[v] = var_Undef;
+    if (last != var_Undef) { next[last] = v; } else { first = v; }
+    last = v;
+    stamp[v] = ++stamps;
+}
+
+void VMTFHeuristic::newVar(Var v, double) {
+    assert(v == prev.size());
+    prev.push(var_Undef);
+    next.push(var_Undef);
+    stamp.push(0);
+    append(v);
+}
+
+void VMTFHeuristic::popVar(Var v) {
+    assert(v == prev.size() - 1);
+    if (search == v) { search = prev[v]; }
+    unlink(v);
+    prev.pop();
+    next.pop();
+    stamp.pop();
+}
+
+void VMTFHeuristic::insert(Var v) {
+    if (search == var_Undef or stamp[v] > stamp[search]) {
+        search = v;
+    }
+}
+
+Var VMTFHeuristic::removeBest() {
+    assert(search != var_Undef);
+    Var best = search;
+    search = prev[search];
+    return best;
+}
+
+Var VMTFHeuristic::randomCandidate(double & seed) const {
+    assert(prev.size() > 0);
+    return opensmt::irand(seed, prev.size());
+}
+
+void VMTFHeuristic::rebuild(vec<Var> & candidates) {
+    search = var_Undef;
+    for (Var v : candidates) {
+        insert(v);
+    }
+}
+
+void VMTFHeuristic::applyBumps() {
+    // Move the bumped variables to the front keeping their relative order
+    std::sort(bumped.begin(), bumped.end(), [this](Var x, Var y) { return stamp[x] < stamp[y]; });
+    for (Var v : bumped) {
+        if (v == search) { search = prev[v]; }
+        unlink(v);
+        append(v);
+        if (assigns[v] == l_Undef) {
+            search = v;
+        }
+    }
+    bumped.clear();
+}
@@ -0,0 +1,137 @@
+#ifndef OPENSMT_DECISIONHEURISTIC_H
+#define OPENSMT_DECISIONHEURISTIC_H
+
+#include "SolverTypes.h"
+#include "Heap.h"
+#include "SMTConfig.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+/**
+ * The order in which the SAT solver picks decision variables.
+ *
+ * A heuristic maintains a queue of candidate variables.  The solver inserts a variable to the queue when the variable
+ * becomes unassigned, and removes the best candidates until it finds an unassigned one.  Assigned variables may remain
+ * in the queue; they are skipped by the solver.  Variables taking part in conflict analysis are bumped, and
+ * conflictDone is called once after each learnt clause.  Every assigned variable is reported to propagated when unit
+ * propagation processes it.
+ */
+class DecisionHeuristic {
+public:
+    virtual ~DecisionHeuristic() = default;
+
+    static std::unique_ptr<DecisionHeuristic> create(vec<lbool> const & assigns, SMTConfig const & config);
+
+    virtual void newVar(Var v, double initialActivity) = 0; // v is the next variable; it is not yet in the queue
+    virtual void popVar(Var v) = 0;                         // Undoes newVar of the last variable
+    virtual void insert(Var v) = 0;                         // v is unassigned and can be decided again
+    virtual bool inQueue(Var v) const = 0;
+    virtual bool empty() const = 0;
+    virtual Var  removeBest() = 0;                          // The best candidate, removed from the queue
+    virtual Var  randomCandidate(double & seed) const = 0;  // A random candidate; the queue must not be empty
+    virtual void rebuild(vec<Var> & candidates) = 0;        // Replace the queue with the given variables
+    virtual void filter(std::function<bool(Var)> const & keep) = 0; // Drop the candidates that are not to be kept
+
+    virtual void bump(Var v) = 0;                           // v took part in the analysis of the current conflict
+    virtual void applyBumps() {}                            // Apply the bumps so far without ending the conflict
+    virtual void conflictDone() = 0;
+    virtual void propagated(Var) {}
+};
+
+/**
+ * Common part of the heuristics that keep the candidates in a heap ordered by a score.
+ */
+class ScoreHeapHeuristic : public DecisionHeuristic {
+protected:
+    struct VarOrderLt {
+        vec<double> const & score;
+        bool operator () (Var x, Var y) const { return score[x] > score[y]; }
+        VarOrderLt(vec<double> const & score) : score(score) { }
+    };
+
+    vec<double>      score;
+    Heap<VarOrderLt> order_heap;
+
+    ScoreHeapHeuristic() : order_heap(VarOrderLt(score)) {}
+public:
+    void newVar(Var v, double initialActivity) override;
+    void popVar(Var v) override;
+    void insert(Var v) override;
+    bool inQueue(Var v) const override { return order_heap.inHeap(v); }
+    bool empty() const override { return order_heap.empty(); }
+    Var  removeBest() override { return order_heap.removeMin(); }
+    Var  randomCandidate(double & seed) const override;
+    void rebuild(vec<Var> & candidates) override { order_heap.build(candidates); }
+    void filter(std::function<bool(Var)> const & keep) override { order_heap.filter(keep); }
+};
+
+/**
+ * Variable state independent decaying sum: bumping adds an exponentially growing increment to the score of the
+ * variable.
+ */
+class VSIDSHeuristic : public ScoreHeapHeuristic {
+    double var_inc = 1;     // Amount to bump next variable with
+    double var_decay;       // Inverse of the variable activity decay factor
+public:
+    VSIDSHeuristic(SMTConfig const & config) : var_decay(config.sat_var_decay()) {}
+    void bump(Var v) override;
+    void conflictDone() override { var_inc *= var_decay; }
+};
+
+/**
+ * Conflict history based branching.  The score of a variable is an exponential moving average of a reward it gets when
+ * it is propagated, the higher the more recently the variable took part in a conflict.
+ */
+class CHBHeuristic : public ScoreHeapHeuristic {
+    static constexpr double initialStepSize = 0.4;
+    static constexpr double minimalStepSize = 0.06;
+    static constexpr double stepSizeDecrement = 1e-6;
+
+    vec<uint64_t> lastConflict; // The number of the last conflict the variable took part in
+    uint64_t      conflicts = 0;
+    double        stepSize = initialStepSize;
+public:
+    void newVar(Var v, double initialActivity) override;
+    void popVar(Var v) override;
+    void bump(Var v) override { lastConflict[v] = conflicts; }
+    void conflictDone() override;
+    void propagated(Var v) override;
+};
+
+/**
+ * Variable move to front.  The variables are in a queue ordered by the time they were last bumped, and bumping a
+ * variable moves it to the front of the queue in constant time.  The candidates are the variables behind a search
+ * cursor; all the variables in front of it are assigned.
+ */
+class VMTFHeuristic : public DecisionHeuristic {
+    vec<lbool> const & assigns;
+    vec<Var>      prev;         // Towards less recently bumped variables
+    vec<Var>      next;         // Towards more recently bumped variables
+    vec<uint64_t> stamp;        // Increasing along the queue
+    Var           first = var_Undef;
+    Var           last = var_Undef;
+    Var           search = var_Undef; // The most recently bumped candidate
+    uint64_t      stamps = 0;
+    vec<Var>      bumped;       // Bumped in the current conflict, moved to the front in conflictDone
+
+    void unlink(Var v);
+    void append(Var v);
+public:
+    VMTFHeuristic(vec<lbool> const & assigns) : assigns(assigns) {}
+    void newVar(Var v, double) override;
+    void popVar(Var v) override;
+    void insert(Var v) override;
+    bool inQueue(Var v) const override { return search != var_Undef and stamp[v] <= stamp[search]; }
+    bool empty() const override { return search == var_Undef; }
+    Var  removeBest() override;
+    Var  randomCandidate(double & seed) const override;
+    void rebuild(vec<Var> & candidates) override;
+    void filter(std::function<bool(Var)> const &) override {} // Assigned variables are skipped by the cursor
+    void bump(Var v) override { bumped.push(v); }
+    void applyBumps() override;
+    void conflictDone() override { applyBumps(); }
+};
+
+#endif //OPENSMT_DECISIONHEURISTIC_H
@@ -89,10 +89,10 @@ GhostSMTSolver::newVar(bool dvar)
 // Random decision:
 Var
 GhostSMTSolver::pickRandomBranchVar() {
-    if (order_heap.empty())
+    if (decisionHeuristic->empty())
         return var_Undef;
     else
-        return order_heap[opensmt::irand(random_seed,order_heap.size())];
+        return decisionHeuristic->randomCandidate(random_seed);
 }
 
 // Activity based decision:
@@ -100,12 +100,12 @@ Var
 GhostSMTSolver::pickBranchVar() {
     Var next;
     while (true) {
-        if (order_heap.empty()) {
+        if (decisionHeuristic->empty()) {
             next = var_Undef;
             break;
         }
         else {
-            next = order_heap.removeMin();
+            next = decisionHeuristic->removeBest();
         }
         if (value(next) == l_Undef && decision[next])
             break;
@@ -132,7 +132,7 @@ GhostSMTSolver::pickBranchPolarity(Var next) {
     }
 
     if (not signSet) {
-        sign = (savedPolarity[next] == flipState);
+        sign = not savedPolarity[next];
     }
 
     Lit l = mkLit(next, sign);
@@ -153,7 +153,7 @@ GhostSMTSolver::pickBranchLit() {
     opensmt::StopWatch s(branchTimer);
 #endif
 
-    if ((opensmt::drand(random_seed) < random_var_freq) && !order_heap.empty()) {
+    if ((opensmt::drand(random_seed) < random_var_freq) && !decisionHeuristic->empty()) {
         Var v = pickRandomBranchVar();
         if (v != var_Undef && value(v) == l_Undef) {
             Lit l = pickBranchPolarity(v);
@@ -18,6 +18,7 @@ Var LookaheadSMTSolver::newVar(bool dvar) {
 
 lbool LookaheadSMTSolver::solve_() {
     declareVarsToTheories();
+    chrono_backtrack = -1; // The lookahead loop analyses conflicts only at the current decision level
 
     double nof_conflicts = restart_first;
 
@@ -94,10 +95,11 @@ lbool LookaheadSMTSolver::laPropagateWrapper() {
                 uncheckedEnqueue(out_learnt[0]);
             } else {
                 CRef crd = ca.alloc(out_learnt, {true, computeGlue(out_learnt)});
-                learnts.push(crd);
+                addLearnt(crd);
                 attachClause(crd);
                 uncheckedEnqueue(out_learnt[0], crd);
             }
+            decisionHeuristic->applyBumps(); // Not a search conflict; VSIDS does not decay here
             diff = true;
         }
         if (!diff) {
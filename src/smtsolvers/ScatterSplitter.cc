@@ -11,11 +11,6 @@
 #include "ReportUtils.h"
 #include "Random.h"
 
-namespace opensmt
-{
-    extern bool stop;
-}
-
 ScatterSplitter::ScatterSplitter(SMTConfig & c, THandler & t)
     : SimpSMTSolver         (c, t)
     , splitContext          (config, decisions)
@@ -24,14 +19,14 @@ ScatterSplitter::ScatterSplitter(SMTConfig & c, THandler & t)
 bool ScatterSplitter::branchLitRandom() {
     return ((not splitContext.isInSplittingCycle() and opensmt::drand(random_seed) < random_var_freq) or
             (splitContext.isInSplittingCycle() and splitContext.preferRandom()))
-           and not order_heap.empty();
+           and not decisionHeuristic->empty();
 }
 
 Var ScatterSplitter::doActivityDecision() {
     vec<int> discarded;
     Var next = var_Undef;
     while (next == var_Undef || value(next) != l_Undef || !decision[next]) {
-        if (order_heap.empty()) {
+        if (decisionHeuristic->empty()) {
             if (splitContext.preferTerm() or splitContext.preferFormula()) {
                 if (discarded.size() > 0) {
                     next = discarded[0];
@@ -43,7 +38,7 @@ Var ScatterSplitter::doActivityDecision() {
             }
             break;
         } else {
-            next = order_heap.removeMin();
+            next = decisionHeuristic->removeBest();
             if (splitContext.isInSplittingCycle() and next != var_Undef) {
                 if (splitContext.preferTerm() and not theory_handler.isDeclared(next)) {
                     discarded.push(next);
@@ -57,16 +52,16 @@ Var ScatterSplitter::doActivityDecision() {
     }
     if (splitContext.preferTerm() or splitContext.preferFormula())
         for (Var v : discarded)
-            order_heap.insert(v);
+            decisionHeuristic->insert(v);
 
     return next;
 }
 
-bool ScatterSplitter::okContinue() const {
+bool ScatterSplitter::okContinue() {
     if (!CoreSMTSolver::okContinue()) {
         return false;
     } else if (conflicts % 1000 == 0 and splitContext.resourceLimitReached(decisions)) {
-        opensmt::stop = true;
+        stop = true;
         return false;
     } else if (static_cast<int>(splitContext.getCurrentSplitCount()) == splitContext.splitTargetNumber() - 1) {
         return false;
@@ -79,7 +74,7 @@ void ScatterSplitter::notifyEnd() {
     splitContext.insertSplitData(std::move(data));
     assert(result == l_False);
     (void)result;
-    opensmt::stop = true;
+    stop = true;
 }
 
 lbool ScatterSplitter::solve_() {
@@ -92,7 +87,7 @@ lbool ScatterSplitter::solve_() {
 
 lbool ScatterSplitter::zeroLevelConflictHandler() {
     if (splitContext.hasCurrentSplits()) {
-        opensmt::stop = true;
+        stop = true;
         return l_Undef;
     } else {
         return CoreSMTSolver::zeroLevelConflictHandler();
@@ -164,7 +159,7 @@ CoreSMTSolver::ConsistencyAction ScatterSplitter::notifyConsistency() {
         auto [data, result] = createSplitAndBlockAssumptions();
         splitContext.insertSplitData(std::move(data));
         if (result == l_False) { // Rest is unsat
-            opensmt::stop = true;
+            stop = true;
             return ConsistencyAction::ReturnUndef;
         } else {
             splitContext.enterTuningCycle(decisions);
@@ -27,7 +27,7 @@ protected:
     lbool solve_() override;
     bool branchLitRandom() override;
     Var doActivityDecision() override;
-    bool okContinue() const override;
+    bool okContinue() override;
     ConsistencyAction notifyConsistency() override;
     void notifyEnd() override;
     lbool zeroLevelConflictHandler() override;                                // Common handling of zero-level conflict as it can happen at multiple places
@@ -285,7 +285,7 @@ CoreSMTSolver::handleUnsat()
     // Learn theory lemma
     else {
         confl = config.sat_temporary_learn ? ca.alloc(conflicting, {true, computeGlue(conflicting)}) : ca.alloc(conflicting);
-        learnts.push(confl);
+        addLearnt(confl);
         attachClause(confl);
         claBumpActivity(ca[confl]);
         learnt_t_lemmata ++;
@@ -308,7 +308,8 @@ CoreSMTSolver::handleUnsat()
         }
     }
 
-    cancelUntil(backtrack_level);
+    int const asserting_level = backtrack_level;
+    cancelUntil(backtrackTarget(backtrack_level));
     assert(value(learnt_clause[0]) == l_Undef);
 
     if (learnt_clause.size() == 1) {
@@ -320,22 +321,25 @@ CoreSMTSolver::handleUnsat()
             reason = cr;
         }
         uncheckedEnqueue(learnt_clause[0], reason);
+        updateGlueAverages(1);
     } else {
         // ADDED FOR NEW MINIMIZATION
         learnts_size += learnt_clause.size( );
         all_learnts ++;
 
-        CRef cr = ca.alloc(learnt_clause, {true, computeGlue(learnt_clause)});
+        uint32_t glue = computeGlue(learnt_clause);
+        updateGlueAverages(glue);
+        CRef cr = ca.alloc(learnt_clause, {true, glue});
 
         if (logsProofForInterpolation()) {
             proof->endChain(cr);
         }
-        learnts.push(cr);
+        addLearnt(cr);
         learnt_theory_conflicts++;
         undo_stack.push(undo_stack_el(undo_stack_el::NEWLEARNT, cr));
         attachClause(cr);
         claBumpActivity(ca[cr]);
-        uncheckedEnqueue(learnt_clause[0], cr);
+        uncheckedEnqueue(learnt_clause[0], cr, asserting_level);
     }
 
     varDecayActivity();
@@ -379,6 +383,7 @@ TPropRes CoreSMTSolver::checkTheory(bool complete, int& conflictC)
     else if (res == TRes::UNSAT) {
         conflicts++;
         conflictC++;
+        blockRestart();
         return handleUnsat();
     }
     assert(res == TRes::UNKNOWN);
@@ -27,7 +27,14 @@ PTRef UFLATHandler::getInterpolant(const ipartitions_t&, std::map<PTRef, icolor_
 
 lbool UFLATHandler::getPolaritySuggestion(PTRef pt) const {
     if (lasolver->isKnown(pt)) { return lasolver->getPolaritySuggestion(pt); }
-    if (ufsolver->isKnown(pt)) { return ufsolver->getPolaritySuggestion(pt); }
+    if (ufsolver->isKnown(pt)) {
+        lbool suggestion = ufsolver->getPolaritySuggestion(pt);
+        // Decide the interface equalities the Egraph has no opinion about as they are in the arithmetic model
+        if (suggestion == l_Undef and logic.isNumEq(pt)) {
+            return lasolver->getInterfaceEqualitySuggestion(pt);
+        }
+        return suggestion;
+    }
     return l_Undef;
 }
 
@@ -43,6 +43,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "GCTest.h"
 #endif
 
+#include <optional>
 #include <unordered_set>
 
 class UFSolverStats
@@ -180,6 +181,30 @@ private:
 
     bool childDuplicatesClass(ERef parent, uint32_t childIndex);
 
+    //***************************************************************************************************************
+    /*
+     * The distinction classes that do not fit in the bit vector of the enodes, indexed by the congruence id of the root.
+     * The classes of a root form a stack that follows the undo stack: asserting a distinction pushes its index to the
+     * roots of the members and merging appends the classes of the old root to those of the new root.
+     */
+    //***************************************************************************************************************
+    std::vector<std::vector<uint32_t>> extraDistClasses;
+    mutable std::vector<char> extraDistMarks;   // Scratch space for intersecting the classes of two roots
+
+    void addDistClass(ERef root, uint32_t index);
+    void clearDistClass(ERef root, uint32_t index);
+    std::optional<uint32_t> commonExtraDistClass(ERef p, ERef q) const;
+
+    //***************************************************************************************************************
+    /*
+     * Propagation of the equality atoms.  The enode of an equality is a parent of its sides, so the use-vectors of a
+     * class give the equalities that a merge or a new distinction of the class can decide.
+     */
+    //***************************************************************************************************************
+    void deduceEquality(ERef parent);
+    void deduceDisequalities(ERef p, ERef q);
+    void deduceDistinction(Map<ERef, ERef, ERefHash> const & roots);
+
     //***************************************************************************************************************
     Map<PTRef, ERef, PTRefHash> negatedTermToERef;
 
@@ -271,6 +296,7 @@ public:
     PTRef      getSuggestion           ();                          // Return a suggested literal based on the current state
     lbool      getPolaritySuggestion   (PTRef);                     // Return a suggested polarity for a given literal
     void       getConflict             (vec<PtAsgn> &) override;
+    vec<PtAsgn> getReasonFor           (PtAsgn lit) override;       // Explain a deduced literal by the equality it follows from
     TRes       check                   (bool) override { return TRes::SAT; }// Check satisfiability
     void       computeModel            () override;
     void       fillTheoryFunctions     (ModelBuilder & modelBuilder) const override;
@@ -396,8 +422,8 @@ private:
     // Helper methods
     void mergeForbidLists(ERef to, const Enode & from);
     void unmergeForbidLists(ERef to, const Enode & from);
-    static void mergeDistinctionClasses(Enode & to, const Enode & from);
-    static void unmergeDistinctionClasses(Enode & to, const Enode & from);
+    void mergeDistinctionClasses(ERef to, ERef from);
+    void unmergeDistinctionClasses(ERef to, ERef from);
     void mergeEquivalenceClasses(ERef newroot, ERef oldroot);
     void unmergeEquivalenceClasses(ERef newroot, ERef oldroot);
     void processParentsBeforeMerge(ERef mergedRoot);
@@ -84,13 +84,13 @@ Egraph::Egraph(SMTConfig & c, Logic & l, ExplainerType explainerType)
     auto rawExplainer = [this](ExplainerType type) -> Explainer * {
         switch(type) {
             case ExplainerType::CLASSIC: {
-                return new Explainer(enode_store);
+                return new Explainer(enode_store, logic);
             }
             case ExplainerType::INTERPOLATING: {
-                return new InterpolatingExplainer(enode_store);
+                return new InterpolatingExplainer(enode_store, logic);
             }
             default: {
-                return new Explainer(enode_store);
+                return new Explainer(enode_store, logic);
             }
         }
     }(explainerType);
@@ -188,6 +188,35 @@ void Egraph::getConflict(vec<PtAsgn> & conflict)
 #endif
 }
 
+vec<PtAsgn> Egraph::getReasonFor(PtAsgn lit) {
+    // A deduced literal follows from its term being equal to a constant, or from the equality of its sides, in the
+    // current state.  The explanation of that equality is its reason; otherwise the negation of the literal is asserted.
+    ERef x = ERef_Undef;
+    ERef y = ERef_Undef;
+    if (isEffectivelyUP(lit.tr)) {
+        x = termToERef(lit.tr);
+        y = lit.sgn == l_True ? enode_store.getEnode_true() : enode_store.getEnode_false();
+    } else if (isEffectivelyEquality(lit.tr) and lit.sgn == l_True) {
+        Pterm const & eq = logic.getPterm(lit.tr);
+        x = termToERef(eq[0]);
+        y = termToERef(eq[1]);
+    }
+    if (x == ERef_Undef or getEnode(x).getRoot() != getEnode(y).getRoot()) {
+        return TSolver::getReasonFor(lit);
+    }
+    vec<PtAsgn> reason = explainer->explain(x, y);
+    reason.push(PtAsgn(lit.tr, lit.sgn == l_True ? l_False : l_True));
+#ifdef STATISTICS
+    if (reason.size() > generalTSolverStats.max_reas_size)
+        generalTSolverStats.max_reas_size = reason.size();
+    if (reason.size() < generalTSolverStats.min_reas_size)
+        generalTSolverStats.min_reas_size = reason.size();
+    generalTSolverStats.reasons_sent ++;
+    generalTSolverStats.avg_reas_size += reason.size();
+#endif // STATISTICS
+    return reason;
+}
+
 void Egraph::clearModel()
 {
     values.reset(nullptr);
@@ -617,6 +646,7 @@ bool Egraph::assertNEq(ERef p, ERef q, Expl const & r)
     }
     // Save operation in undo_stack
     undo_stack_main.push( Undo(DISEQ, q) );
+    deduceDisequalities(p, q);
     return true;
 }
 
@@ -650,7 +680,7 @@ bool Egraph::assertDist( PTRef tr_d, PtAsgn tr_r )
 
         // Activate distinction in e
         // This should be done for the root of en_c, not en_c
-        getEnode(root).addDistClass(index);
+        addDistClass(root, index);
         nodes_changed.push(root);
     }
 
@@ -665,22 +695,79 @@ bool Egraph::assertDist( PTRef tr_d, PtAsgn tr_r )
         // Revert changes, as the current context is inconsistent
         for (ERef n : nodes_changed) {
             // Deactivate distinction in n
-            getEnode(n).clearDistClass(index);
+            clearDistClass(n, index);
         }
         return false;
     }
     assert(inConflict == ERef_Undef);
     // Distinction pushed without conflict
     undo_stack_main.push(Undo(DIST, tr_d));
+    deduceDistinction(root_to_enode);
     return true;
 }
 
 void Egraph::undoDistinction(PTRef tr_d) {
     auto index = enode_store.getDistIndex(tr_d);
     Pterm const & pt_d = logic.getPterm(tr_d);
+    // The merges done after the distinction have been undone, so the roots are those the distinction was asserted on
     for (PTRef tr_c : pt_d) {
-        getEnode(enode_store.getERef(tr_c)).clearDistClass(index);
+        clearDistClass(getEnode(enode_store.getERef(tr_c)).getRoot(), index);
+    }
+}
+
+void Egraph::addDistClass(ERef root, uint32_t index) {
+    assert(getEnode(root).getRoot() == root);
+    if (index < maxDistinctClasses) {
+        getEnode(root).addDistClass(index);
+        return;
+    }
+    auto cid = getEnode(root).getCid();
+    if (cid >= extraDistClasses.size()) {
+        extraDistClasses.resize(cid + 1);
+    }
+    if (index - maxDistinctClasses >= extraDistMarks.size()) {
+        extraDistMarks.resize(index - maxDistinctClasses + 1, 0);
+    }
+    extraDistClasses[cid].push_back(index);
+}
+
+void Egraph::clearDistClass(ERef root, uint32_t index) {
+    if (index < maxDistinctClasses) {
+        getEnode(root).clearDistClass(index);
+        return;
     }
+    auto & classes = extraDistClasses[getEnode(root).getCid()];
+    assert(not classes.empty() and classes.back() == index);
+    classes.pop_back();
+}
+
+/**
+ * Finds a distinction class beyond the bit vectors that contains both roots.
+ * Runs in time linear in the number of their classes.
+ */
+std::optional<uint32_t> Egraph::commonExtraDistClass(ERef p, ERef q) const {
+    auto pcid = getEnode(p).getCid();
+    auto qcid = getEnode(q).getCid();
+    if (pcid >= extraDistClasses.size() or qcid >= extraDistClasses.size()) { return std::nullopt; }
+    auto const & pclasses = extraDistClasses[pcid];
+    auto const & qclasses = extraDistClasses[qcid];
+    if (pclasses.empty() or qclasses.empty()) { return std::nullopt; }
+    auto const & smaller = pclasses.size() <= qclasses.size() ? pclasses : qclasses;
+    auto const & larger = pclasses.size() <= qclasses.size() ? qclasses : pclasses;
+    for (uint32_t index : smaller) {
+        extraDistMarks[index - maxDistinctClasses] = 1;
+    }
+    std::optional<uint32_t> common;
+    for (uint32_t index : larger) {
+        if (extraDistMarks[index - maxDistinctClasses]) {
+            common = index;
+            break;
+        }
+    }
+    for (uint32_t index : smaller) {
+        extraDistMarks[index - maxDistinctClasses] = 0;
+    }
+    return common;
 }
 
 //
@@ -788,11 +875,35 @@ void Egraph::merge ( ERef x, ERef y, PtAsgn reason )
     // MB: Before we actually merge the classes, we check if we are not merging with eq. class of constant True or False
     deduce( x, y, reason );
 
-    Enode & en_x = getEnode(x);
     Enode const & en_y = getEnode(y);
 
     assert(not isConstant(y));
 
+    // The classes y is distinct from become distinct from x; collect them before the forbid lists and the distinction
+    // classes are merged
+    vec<ERef> forbidden;
+    if (en_y.getForbid() != ELRef_Undef) {
+        ELRef elr = en_y.getForbid();
+        do {
+            Elist const & el = forbid_allocator[elr];
+            forbidden.push(getEnode(el.e).getRoot());
+            elr = el.link;
+        } while (elr != en_y.getForbid());
+    }
+    auto collectDistinction = [&](uint32_t index) {
+        for (PTRef tr : logic.getPterm(enode_store.getDistTerm(index))) {
+            ERef root = getEnode(enode_store.getERef(tr)).getRoot();
+            if (root != y) { forbidden.push(root); }
+        }
+    };
+    unsigned index = 0;
+    for (dist_t classes = en_y.getDistClasses(); classes != 0; classes = classes >> 1, ++index) {
+        if (classes & 1) { collectDistinction(index); }
+    }
+    if (en_y.getCid() < extraDistClasses.size()) {
+        for (uint32_t extraIndex : extraDistClasses[en_y.getCid()]) { collectDistinction(extraIndex); }
+    }
+
     // Step 2: Propagate equalities to other ordinary theories
     // MB: We are not doing that
     // Step 3: MB: Also not relevant for us
@@ -804,7 +915,7 @@ void Egraph::merge ( ERef x, ERef y, PtAsgn reason )
     checkForbidReferences(x);
 #endif
     // Step 4: Merge distinction classes
-    mergeDistinctionClasses(en_x, en_y);
+    mergeDistinctionClasses(x, y);
 
     // Step 5: Consists of several operations
 
@@ -817,6 +928,11 @@ void Egraph::merge ( ERef x, ERef y, PtAsgn reason )
     // Step 5.5: Insert new signatures and propagate congruences
     processParentsAfterMerge(y);
 
+    // Step 5.6: Deduce the equalities between the parents of x and the classes y was distinct from
+    for (ERef root : forbidden) {
+        deduceDisequalities(x, root);
+    }
+
     // Step 6: Merge parent lists -> done in 5.5
     // Step 7: Not relevant -> skipped
 
@@ -905,6 +1021,68 @@ void Egraph::deduce( ERef x, ERef y, PtAsgn reason ) {
     }
 }
 
+//
+// Deduce the equality of the parent, if it is one, when its sides are now in the same class or in distinct classes
+//
+void Egraph::deduceEquality(ERef parent) {
+    Enode const & node = getEnode(parent);
+    PTRef eq = node.getTerm();
+    // An equality appearing in UF must be asserted for its enode to join the class of true or false
+    if (node.getSize() != 2 or not logic.isTheoryEquality(eq) or hasPolarity(eq) or logic.appearsInUF(eq)) { return; }
+    ERef lhs = getEnode(node[0]).getRoot();
+    ERef rhs = getEnode(node[1]).getRoot();
+    Expl r;
+    if (lhs == rhs) {
+        storeDeduction(PtAsgn_reason(eq, l_True, PTRef_Undef));
+    } else if (unmergeable(lhs, rhs, r)) {
+        storeDeduction(PtAsgn_reason(eq, l_False, PTRef_Undef));
+    } else {
+        return;
+    }
+#ifdef STATISTICS
+    generalTSolverStats.deductions_done ++;
+#endif
+}
+
+//
+// Deduce the equalities between the classes p and q that were just made distinct
+//
+void Egraph::deduceDisequalities(ERef p, ERef q) {
+    if (getParentsSize(p) > getParentsSize(q)) { std::swap(p, q); }
+    for (auto entry : parents[getEnode(p).getCid()]) {
+        if (not entry.isValid()) { continue; }
+        ERef parent = UseVector::entryToERef(entry);
+        Enode const & node = getEnode(parent);
+        if (node.getSize() != 2) { continue; }
+        ERef lhs = getEnode(node[0]).getRoot();
+        ERef rhs = getEnode(node[1]).getRoot();
+        if ((lhs == p and rhs == q) or (lhs == q and rhs == p)) {
+            deduceEquality(parent);
+        }
+    }
+}
+
+//
+// Deduce the equalities between the classes of a distinction that was just asserted
+//
+void Egraph::deduceDistinction(Map<ERef, ERef, ERefHash> const & roots) {
+    vec<ERef> distinctRoots;
+    roots.getKeys(distinctRoots);
+    for (ERef root : distinctRoots) {
+        for (auto entry : parents[getEnode(root).getCid()]) {
+            if (not entry.isValid()) { continue; }
+            ERef parent = UseVector::entryToERef(entry);
+            Enode const & node = getEnode(parent);
+            if (node.getSize() != 2) { continue; }
+            ERef lhs = getEnode(node[0]).getRoot();
+            ERef rhs = getEnode(node[1]).getRoot();
+            if (lhs != rhs and roots.has(lhs) and roots.has(rhs)) {
+                deduceEquality(parent);
+            }
+        }
+    }
+}
+
 //
 // Starts with the E-graph state that existed after the
 // pertinent merge and restores the E-graph to the state
@@ -922,8 +1100,6 @@ void Egraph::undoMerge( ERef y )
     ERef x = en_y.getRoot( );
     assert( x != ERef_Undef );
 
-    Enode & en_x = enode_store[x];
-
     // Undo Step 6 of merge:
 //    unmergeParentLists(en_x, en_y);
 
@@ -942,7 +1118,7 @@ void Egraph::undoMerge( ERef y )
     processParentsAfterUnMerge(y);
 
     // Undo step 4 of Merge
-    unmergeDistinctionClasses(en_x, en_y);
+    unmergeDistinctionClasses(x, y);
     unmergeForbidLists(x, en_y);
 
     // Undo Step 2 -> not relevant
@@ -1061,6 +1237,10 @@ bool Egraph::unmergeable(ERef x, ERef y, Expl& r) const
         r = Expl(Expl::Type::std, {ineq_tr, l_True}, PTRef_Undef);
         return true;
     }
+    if (auto index = commonExtraDistClass(p, q)) {
+        r = Expl(Expl::Type::std, {enode_store.getDistTerm(*index), l_True}, PTRef_Undef);
+        return true;
+    }
     // Check forbid lists (binary distinction)
     ELRef pstart = en_p.getForbid();
     ELRef qstart = en_q.getForbid();
@@ -1298,12 +1478,30 @@ void Egraph::mergeForbidLists(ERef toRef, const Enode & from) {
     }
 }
 
-void Egraph::mergeDistinctionClasses(Enode & to, const Enode & from) {
+void Egraph::mergeDistinctionClasses(ERef toRef, ERef fromRef) {
+    Enode & to = getEnode(toRef);
+    Enode const & from = getEnode(fromRef);
     to.setDistClasses( ( to.getDistClasses( ) | from.getDistClasses( ) ) );
+    if (from.getCid() < extraDistClasses.size() and not extraDistClasses[from.getCid()].empty()) {
+        if (to.getCid() >= extraDistClasses.size()) {
+            extraDistClasses.resize(to.getCid() + 1);
+        }
+        auto const & fromClasses = extraDistClasses[from.getCid()];
+        auto & toClasses = extraDistClasses[to.getCid()];
+        toClasses.insert(toClasses.end(), fromClasses.begin(), fromClasses.end());
+    }
 }
 
-void Egraph::unmergeDistinctionClasses(Enode & to, const Enode & from) {
+void Egraph::unmergeDistinctionClasses(ERef toRef, ERef fromRef) {
+    Enode & to = getEnode(toRef);
+    Enode const & from = getEnode(fromRef);
     to.setDistClasses( ( to.getDistClasses() & ~(from.getDistClasses())) );
+    if (from.getCid() < extraDistClasses.size() and not extraDistClasses[from.getCid()].empty()) {
+        auto const & fromClasses = extraDistClasses[from.getCid()];
+        auto & toClasses = extraDistClasses[to.getCid()];
+        assert(toClasses.size() >= fromClasses.size());
+        toClasses.resize(toClasses.size() - fromClasses.size());
+    }
 }
 
 void Egraph::mergeEquivalenceClasses(ERef newroot, ERef oldroot) {
@@ -1417,6 +1615,7 @@ void Egraph::processParentsAfterMerge(ERef oldroot) {
                 enode_store.insertSig(parent);
                 addToUseVectors(parent);
             }
+            deduceEquality(parent);
         }
     }
 }
@@ -1631,17 +1830,16 @@ vec<PTRef> Egraph::collectEqualitiesFor(vec<PTRef> const & vars, std::unordered_
         it->second.push(eref);
     }
 
+    // A chain through each class is enough: the other solver derives the rest of the equalities by transitivity
     for (auto const & entry : eqClasses) {
         auto const & equivalentVars = entry.second;
-        for (int i = 0; i < equivalentVars.size(); ++i) {
-            for (int j = i + 1; j < equivalentVars.size(); ++j) {
-                PTRef eq = logic.mkEq(ERefToTerm(equivalentVars[i]), ERefToTerm(equivalentVars[j]));
-                if (not enode_store.has(eq)) {
-                    if (knownEqualities.find(eq) != knownEqualities.end()) {
-                        throw OsmtInternalException("Internal error in computing interface equalities in Egraph");
-                    }
-                    equalities.push(eq);
+        for (int i = 0; i + 1 < equivalentVars.size(); ++i) {
+            PTRef eq = logic.mkEq(ERefToTerm(equivalentVars[i]), ERefToTerm(equivalentVars[i + 1]));
+            if (not enode_store.has(eq)) {
+                if (knownEqualities.find(eq) != knownEqualities.end()) {
+                    throw OsmtInternalException("Internal error in computing interface equalities in Egraph");
                 }
+                equalities.push(eq);
             }
         }
     }
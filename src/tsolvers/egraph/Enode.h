@@ -35,6 +35,8 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "TypeUtils.h"
 #include "CgTypes.h"
 
+#include <atomic>
+
 struct ERef {
     uint32_t x;
     void operator= (uint32_t v) { x = v; }
@@ -74,7 +76,7 @@ class EnodeAllocator;
 class Enode final
 {
 private:
-    static uint32_t cgid_ctr;
+    static std::atomic<uint32_t> cgid_ctr; // Shared by all egraphs, possibly running in different threads
 
     ERef    root;           // The root of this enode's equivalence class
     cgId    cid;            // The congruence id of the enode (never changes)
@@ -129,8 +131,8 @@ public:
     PTRef getTerm       ()        const { return pterm; }
     ELRef getForbid     ()        const { return forbid; }
     void  setForbid     (ELRef r)       { forbid = r; }
-    void addDistClass(uint32_t index) { assert(index <= 32); setDistClasses(getDistClasses() | setbit(index)); }
-    void clearDistClass(uint32_t index) { assert(index <= 32); setDistClasses(getDistClasses() & ~setbit(index)); }
+    void addDistClass(uint32_t index) { assert(index < maxDistinctClasses); setDistClasses(getDistClasses() | setbit(index)); }
+    void clearDistClass(uint32_t index) { assert(index < maxDistinctClasses); setDistClasses(getDistClasses() & ~setbit(index)); }
     void  setDistClasses( const dist_t& d) { dist_classes = d; }
     dist_t getDistClasses() const { return dist_classes; }
 
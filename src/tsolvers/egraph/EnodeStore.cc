@@ -31,7 +31,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 EnodeStore::EnodeStore(Logic& l)
       : logic(l)
       , ea(1024*1024)
-      , sig_tab(SignatureHash(ea), SignatureEqual(ea))
+      , sig_tab(ea)
       , dist_idx(0)
 {
     // For the uninterpreted predicates and propositional structures inside
@@ -75,6 +75,9 @@ ERef EnodeStore::addTerm(PTRef term) {
         args.push(termToERef[arg]);
     }
     ERef newEnode = ea.alloc(symref, opensmt::span(args.begin(), args.size_()) , term);
+    if (args.size() > 0) {
+        sig_tab.reserve(++numApplications);
+    }
 
     termToERef.insert(term, newEnode);
     assert(not ERefToTerm.has(newEnode));
@@ -28,7 +28,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define ENODESTORE_H
 
 #include "Enode.h"
-#include "OsmtInternalException.h"
+#include "SignatureTable.h"
 
 class Logic;
 
@@ -36,45 +36,13 @@ struct PTRefERefPair { PTRef tr; ERef er; };
 
 class EnodeStore {
 
-    struct SignatureHash {
-        EnodeAllocator const & ea;
-
-        SignatureHash(EnodeAllocator const & ea) : ea{ea} {}
-
-        // Hash function from https://stackoverflow.com/questions/20511347/a-good-hash-function-for-a-vector
-        std::size_t operator()(ERef ref) const {
-            Enode const & node = ea[ref];
-            std::size_t seed = node.getSymbol().x;
-            for (uint32_t i = 0; i < node.getSize(); ++i) {
-                seed ^= ea[node[i]].getRoot().x + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            }
-            return seed;
-        }
-    };
-
-    struct SignatureEqual {
-        EnodeAllocator const & ea;
-
-        SignatureEqual(EnodeAllocator const & ea) : ea{ea} {}
-
-        bool operator()(ERef a, ERef b) const {
-            if (a == b) { return true; }
-            Enode const & anode = ea[a];
-            Enode const & bnode = ea[b];
-            if (anode.getSize() != bnode.getSize() or anode.getSymbol() != bnode.getSymbol()) { return false; }
-            for (uint32_t i = 0; i < anode.getSize(); ++i) {
-                if (ea[anode[i]].getRoot() != ea[bnode[i]].getRoot()) { return false; }
-            }
-            return true;
-        }
-    };
-
     Logic&         logic;
     EnodeAllocator ea;
-    Map<ERef, ERef, SignatureHash, SignatureEqual> sig_tab;
+    SignatureTable sig_tab;
+    std::size_t    numApplications = 0;              // The enodes with children, which are the ones with a signature
     ERef           ERef_True;
     ERef           ERef_False;
-    Map<PTRef,char,PTRefHash,Equal<PTRef> > dist_classes;
+    Map<PTRef,uint32_t,PTRefHash,Equal<PTRef> > dist_classes;
     uint32_t       dist_idx;
 
     Map<PTRef,ERef,PTRefHash,Equal<PTRef> >    termToERef;
@@ -118,18 +86,15 @@ public:
           Enode& operator[] (PTRef tr)       { return ea[termToERef[tr]]; }
     const Enode& operator[] (PTRef tr) const { return ea[termToERef[tr]]; }
 
-    char getDistIndex(PTRef tr_d) const {
+    uint32_t getDistIndex(PTRef tr_d) const {
         assert(dist_classes.has(tr_d));
         return dist_classes[tr_d];
     }
 
-    PTRef getDistTerm(dist_t idx) const { return index_to_dist[idx]; }
+    PTRef getDistTerm(uint32_t idx) const { return index_to_dist[idx]; }
 
     void addDistClass(PTRef tr_d) {
         if (dist_classes.has(tr_d)) { return; }
-        if (dist_idx >= maxDistinctClasses) {
-            throw OsmtInternalException();
-        }
         dist_classes.insert(tr_d, dist_idx);
         assert(index_to_dist.size_() == dist_idx);
         index_to_dist.push(tr_d);
@@ -137,12 +102,11 @@ public:
     }
 
     inline bool containsSig(ERef e) const {
-        return lookupSig(e) != ERef_Undef;
+        return sig_tab.contains(e);
     }
 
     inline ERef lookupSig(ERef e) const {
-        bool found = sig_tab.peek(e, e);
-        return found ? e : ERef_Undef;
+        return sig_tab.lookup(e);
     }
 
     inline void removeSig(ERef e) {
@@ -152,8 +116,7 @@ public:
     }
 
     inline void insertSig(ERef e) {
-        assert(not containsSig(e));
-        sig_tab.insert(e,e);
+        sig_tab.insert(e);
         assert(containsSig(e));
     }
 };
@@ -100,7 +100,7 @@ vec<PtAsgn> Explainer::explain(opensmt::pair<ERef,ERef> nodePair) {
     congruences.clear();
 #endif
 
-    DupChecker dupChecker(dcd);
+    DupChecker dupChecker(dcd, logic);
     vec<PtAsgn> explanation;
     PendingQueue exp_pending;
     exp_pending.push(nodePair);
@@ -130,7 +130,24 @@ vec<PtAsgn> Explainer::explain(opensmt::pair<ERef,ERef> nodePair) {
 //
 vec<PtAsgn> Explainer::explain(ERef x, ERef y)
 {
-    return explain({x, y});
+#ifdef EXPLICIT_CONGRUENCE_EXPLANATIONS
+    return explain({x, y}); // The congruences are collected as a side effect of the computation
+#else
+    uint64_t key = pairKey(x, y);
+    if (auto it = explanationCacheIndex.find(key); it != explanationCacheIndex.end()) {
+        auto const & cached = explanationCache[it->second].explanation;
+        vec<PtAsgn> explanation;
+        explanation.capacity(cached.size());
+        for (PtAsgn lit : cached) {
+            explanation.push(lit);
+        }
+        return explanation;
+    }
+    vec<PtAsgn> explanation = explain({x, y});
+    explanationCacheIndex.emplace(key, explanationCache.size());
+    explanationCache.push_back({key, exp_undo_stack.size_(), std::vector<PtAsgn>(explanation.begin(), explanation.end())});
+    return explanation;
+#endif
 }
 
 void Explainer::cleanup() {
@@ -236,14 +253,18 @@ void Explainer::makeUnion(ERef x, ERef y) {
 // and meanwhile do path compression
 //
 ERef Explainer::findAndCompress(ERef x) {
-    // If x is the root, return x
-    if (getEnode(x).getExpRoot() == x) return x;
-    // Recurse
-    ERef exp_root = findAndCompress(getEnode(x).getExpRoot());
+    ERef exp_root = x;
+    while (getEnode(exp_root).getExpRoot() != exp_root) {
+        exp_root = getEnode(exp_root).getExpRoot();
+    }
     // Path compression
-    if (exp_root != getEnode(x).getExpRoot()) {
-        getEnode(x).setExpRoot(exp_root);
-        exp_cleanup.push(x);
+    while (x != exp_root) {
+        ERef next = getEnode(x).getExpRoot();
+        if (next != exp_root) {
+            getEnode(x).setExpRoot(exp_root);
+            exp_cleanup.push(x);
+        }
+        x = next;
     }
     return exp_root;
 }
@@ -318,6 +339,11 @@ void Explainer::removeExplanation() {
         getEnode(y).setExpParent(ERef_Undef);
         getEnode(y).setExpReason(PtAsgn_Undef);
     }
+    // Drop the explanations that may depend on the removed edge
+    while (not explanationCache.empty() and explanationCache.back().edges > exp_undo_stack.size_()) {
+        explanationCacheIndex.erase(explanationCache.back().key);
+        explanationCache.pop_back();
+    }
 }
 
 PtAsgn InterpolatingExplainer::explainEdge(ERef from, ERef to, PendingQueue &exp_pending, DupChecker &dc) {
@@ -333,5 +359,6 @@ PtAsgn InterpolatingExplainer::explainEdge(ERef from, ERef to, PendingQueue &exp
 vec<PtAsgn> InterpolatingExplainer::explain(ERef x, ERef y) {
     cgraph.reset(new CGraph());
     cgraph->setConf(getEnode(x).getTerm(), getEnode(y).getTerm());
-    return Explainer::explain(x,y);
+    // Not cached, since the graph is built while computing the explanation
+    return Explainer::explain({x, y});
 }
@@ -7,7 +7,11 @@
 
 #include "EnodeStore.h"
 #include "UFInterpolator.h"
+
+#include <algorithm>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 class Explainer {
 protected:
@@ -16,28 +20,38 @@ protected:
     //
     struct DupChecker;
     class DuplicateCheckerData {
-        Map<PTRef,int,PTRefHash>    duplicates;                       // Fast duplicate checking
-        int                         dup_count = 0;                    // Current dup token
+        std::vector<uint32_t>       duplicates;                       // Dup token of each term, indexed by the term id
+        uint32_t                    dup_count = 0;                    // Current dup token
         bool                        free = true;
         friend                      struct DupChecker;
     };
 
     struct DupChecker {
         DuplicateCheckerData &dc;
-        DupChecker(DuplicateCheckerData &dc) : dc(dc) {
+        Logic const & logic;
+        DupChecker(DuplicateCheckerData &dc, Logic const & logic) : dc(dc), logic(logic) {
             if (!dc.free) {
                 throw OsmtInternalException(); // "Attempt to re-use DuplicateChecker without releasing"
             }
             dc.free = false;
-            if (dc.dup_count < std::numeric_limits<int>::max()) {
+            if (dc.dup_count < std::numeric_limits<uint32_t>::max()) {
                 ++dc.dup_count;
             } else {
-                dc.duplicates.clear();
-                dc.dup_count = 0;
+                std::fill(dc.duplicates.begin(), dc.duplicates.end(), 0);
+                dc.dup_count = 1;
             }
         }
-        inline void storeDup(PTRef e) { assert(!dc.free); if (dc.duplicates.has(e)) dc.duplicates[e] = dc.dup_count; else dc.duplicates.insert(e, dc.dup_count); }
-        inline bool isDup   (PTRef e) { assert(!dc.free); return !dc.duplicates.has(e) ? false : dc.duplicates[e] == dc.dup_count; }
+        inline void storeDup(PTRef e) {
+            assert(!dc.free);
+            auto index = Idx(logic.getPterm(e).getId());
+            if (index >= dc.duplicates.size()) { dc.duplicates.resize(index + 1, 0); }
+            dc.duplicates[index] = dc.dup_count;
+        }
+        inline bool isDup   (PTRef e) {
+            assert(!dc.free);
+            auto index = Idx(logic.getPterm(e).getId());
+            return index < dc.duplicates.size() and dc.duplicates[index] == dc.dup_count;
+        }
         ~DupChecker() {
             dc.free = true;
         }
@@ -46,6 +60,7 @@ protected:
     DuplicateCheckerData dcd;
 
     EnodeStore & store;
+    Logic const & logic;
 
     Enode const & getEnode(ERef ref) const { return store[ref]; }
     Enode & getEnode(ERef ref) { return store[ref]; }
@@ -74,8 +89,26 @@ protected:
     int             time_stamp = 0;                   // Need for finding NCA
 
     vec<opensmt::pair<PTRef,PTRef>> congruences;
+
+    //
+    // Explanations of the pairs explained so far.  An explanation stays valid as long as the merges it was computed
+    // from, so an entry is dropped when exp_undo_stack shrinks below its size at the time of the explanation.  The
+    // sizes of the entries are non-decreasing, and the invalid entries are always at the end.
+    //
+    struct CachedExplanation {
+        uint64_t key;
+        uint32_t edges;                               // Size of exp_undo_stack when the explanation was computed
+        std::vector<PtAsgn> explanation;
+    };
+    std::vector<CachedExplanation> explanationCache;
+    std::unordered_map<uint64_t, std::size_t> explanationCacheIndex;
+
+    static uint64_t pairKey(ERef x, ERef y) {
+        if (y.x < x.x) { std::swap(x, y); }
+        return (static_cast<uint64_t>(x.x) << 32) | y.x;
+    }
 public:
-    Explainer(EnodeStore & store) : store(store) {}
+    Explainer(EnodeStore & store, Logic const & logic) : store(store), logic(logic) {}
     virtual ~Explainer() = default;
 
     void                storeExplanation    (ERef, ERef, PtAsgn);        // Store the explanation for the merge
@@ -90,7 +123,7 @@ protected:
 
     virtual PtAsgn explainEdge (ERef, ERef, PendingQueue &exp_pending, DupChecker& dc) override;
 public:
-    InterpolatingExplainer(EnodeStore & store) : Explainer(store) {}
+    InterpolatingExplainer(EnodeStore & store, Logic const & logic) : Explainer(store, logic) {}
 
     virtual vec<PtAsgn> explain     (ERef, ERef) override;
     std::unique_ptr<CGraph> getCGraph() { return std::move(cgraph); }
@@ -0,0 +1,119 @@
+#ifndef OPENSMT_SIGNATURETABLE_H
+#define OPENSMT_SIGNATURETABLE_H
+
+#include "Enode.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+/**
+ * The congruence table of the Egraph: the enodes keyed by their signature, i.e., the symbol and the roots of the
+ * children.
+ *
+ * The table uses open addressing with linear probing and caches the hash of the signature in each entry.  An enode is
+ * removed while its signature is the one it was inserted with, and the removal shifts the following entries of the
+ * cluster back instead of leaving a tombstone, so the table does not degrade under the removals and reinsertions of
+ * merging and backtracking.
+ */
+class SignatureTable {
+    struct Entry {
+        uint32_t hash;
+        ERef ref;
+    };
+
+    EnodeAllocator const & ea;
+    std::vector<Entry> entries;
+    uint32_t mask;
+    std::size_t count = 0;
+
+    static constexpr std::size_t minCapacity = 64;
+
+    // Hash function from https://stackoverflow.com/questions/20511347/a-good-hash-function-for-a-vector
+    uint32_t signatureHash(ERef ref) const {
+        Enode const & node = ea[ref];
+        uint32_t seed = node.getSymbol().x;
+        for (uint32_t i = 0; i < node.getSize(); ++i) {
+            seed ^= ea[node[i]].getRoot().x + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+
+    bool sameSignature(ERef a, ERef b) const {
+        if (a == b) { return true; }
+        Enode const & anode = ea[a];
+        Enode const & bnode = ea[b];
+        if (anode.getSize() != bnode.getSize() or anode.getSymbol() != bnode.getSymbol()) { return false; }
+        for (uint32_t i = 0; i < anode.getSize(); ++i) {
+            if (ea[anode[i]].getRoot() != ea[bnode[i]].getRoot()) { return false; }
+        }
+        return true;
+    }
+
+    void rehash(std::size_t capacity) {
+        assert((capacity & (capacity - 1)) == 0 and capacity >= 2 * count);
+        std::vector<Entry> old(capacity, Entry{0, ERef_Undef});
+        old.swap(entries);
+        mask = static_cast<uint32_t>(capacity - 1);
+        for (Entry const & entry : old) {
+            if (entry.ref == ERef_Undef) { continue; }
+            uint32_t i = entry.hash & mask;
+            while (entries[i].ref != ERef_Undef) { i = (i + 1) & mask; }
+            entries[i] = entry;
+        }
+    }
+
+public:
+    explicit SignatureTable(EnodeAllocator const & ea) : ea(ea), entries(minCapacity, Entry{0, ERef_Undef}), mask(minCapacity - 1) {}
+
+    // Make room for the given number of signatures, keeping the load factor at most one half
+    void reserve(std::size_t size) {
+        std::size_t capacity = entries.size();
+        while (capacity < 2 * size) { capacity *= 2; }
+        if (capacity != entries.size()) { rehash(capacity); }
+    }
+
+    std::size_t size() const { return count; }
+
+    // The enode in the table with the same signature as ref, or ERef_Undef if there is none
+    ERef lookup(ERef ref) const {
+        uint32_t const hash = signatureHash(ref);
+        for (uint32_t i = hash & mask; entries[i].ref != ERef_Undef; i = (i + 1) & mask) {
+            if (entries[i].hash == hash and sameSignature(entries[i].ref, ref)) { return entries[i].ref; }
+        }
+        return ERef_Undef;
+    }
+
+    bool contains(ERef ref) const { return lookup(ref) != ERef_Undef; }
+
+    void insert(ERef ref) {
+        assert(not contains(ref));
+        if (2 * (count + 1) > entries.size()) { rehash(2 * entries.size()); }
+        uint32_t const hash = signatureHash(ref);
+        uint32_t i = hash & mask;
+        while (entries[i].ref != ERef_Undef) { i = (i + 1) & mask; }
+        entries[i] = Entry{hash, ref};
+        ++count;
+    }
+
+    // Removes ref itself; its signature must not have changed since it was inserted
+    void remove(ERef ref) {
+        uint32_t hole = signatureHash(ref) & mask;
+        while (entries[hole].ref != ref) {
+            assert(entries[hole].ref != ERef_Undef);
+            hole = (hole + 1) & mask;
+        }
+        // Move back every entry of the cluster whose home slot is not between the hole and the entry
+        for (uint32_t i = (hole + 1) & mask; entries[i].ref != ERef_Undef; i = (i + 1) & mask) {
+            uint32_t const home = entries[i].hash & mask;
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                entries[hole] = entries[i];
+                hole = i;
+            }
+        }
+        entries[hole].ref = ERef_Undef;
+        --count;
+    }
+};
+
+#endif //OPENSMT_SIGNATURETABLE_H
@@ -0,0 +1,147 @@
+#include "FloatSimplex.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void FloatSimplex::addVar(unsigned var, double value) {
+    if (var >= values.size()) {
+        values.resize(var + 1, 0);
+        lower.resize(var + 1, 0);
+        upper.resize(var + 1, 0);
+        hasLower.resize(var + 1, false);
+        hasUpper.resize(var + 1, false);
+        basic.resize(var + 1, false);
+        rows.resize(var + 1);
+        columns.resize(var + 1);
+        visited.resize(var + 1, 0);
+    }
+    values[var] = value;
+}
+
+void FloatSimplex::setLowerBound(unsigned var, double bound) {
+    assert(var < values.size());
+    hasLower[var] = true;
+    lower[var] = bound;
+}
+
+void FloatSimplex::setUpperBound(unsigned var, double bound) {
+    assert(var < values.size());
+    hasUpper[var] = true;
+    upper[var] = bound;
+}
+
+void FloatSimplex::addRow(unsigned basicVar, std::vector<Term> const & terms) {
+    assert(basicVar < values.size() and not basic[basicVar]);
+    basic[basicVar] = true;
+    for (Term const & term : terms) {
+        assert(term.var < values.size() and not basic[term.var]);
+        rows[basicVar].emplace(term.var, term.coeff);
+        columns[term.var].push_back(basicVar);
+    }
+}
+
+bool FloatSimplex::isCloseTo(double value, double bound) const {
+    return std::fabs(value - bound) <= tolerance * (1 + std::fabs(bound));
+}
+
+void FloatSimplex::updateViolated(unsigned var) {
+    if (basic[var] and (belowLower(var) or aboveUpper(var))) {
+        violated.insert(var);
+    } else {
+        violated.erase(var);
+    }
+}
+
+std::vector<unsigned> FloatSimplex::rowsWith(unsigned nonBasicVar) {
+    ++stamp;
+    auto & column = columns[nonBasicVar];
+    // Drop the rows that no longer contain the variable and the duplicates while collecting the rest
+    std::size_t kept = 0;
+    for (unsigned row : column) {
+        if (basic[row] and visited[row] != stamp and rows[row].count(nonBasicVar) > 0) {
+            visited[row] = stamp;
+            column[kept++] = row;
+        }
+    }
+    column.resize(kept);
+    return column;
+}
+
+bool FloatSimplex::run(std::size_t maxPivots) {
+    violated.clear();
+    for (unsigned var = 0; var < basic.size(); ++var) {
+        updateViolated(var);
+    }
+    while (not violated.empty()) {
+        if (pivots >= maxPivots) { return false; }
+        unsigned const basicVar = *violated.begin();
+        bool const increase = belowLower(basicVar);
+        // Bland's rule: the non-basic variable with the smallest id that can move the basic variable towards its bound
+        unsigned entering = static_cast<unsigned>(values.size());
+        for (auto const & term : rows[basicVar]) {
+            if (term.first >= entering or std::fabs(term.second) < minimalPivot) { continue; }
+            bool const up = increase == (term.second > 0);
+            bool const canMove = up ? (not hasUpper[term.first] or values[term.first] < upper[term.first])
+                                    : (not hasLower[term.first] or values[term.first] > lower[term.first]);
+            if (canMove) {
+                entering = term.first;
+            }
+        }
+        if (entering == values.size()) { return false; }
+        pivot(basicVar, entering, increase ? lower[basicVar] : upper[basicVar]);
+    }
+    return true;
+}
+
+void FloatSimplex::pivot(unsigned basicVar, unsigned nonBasicVar, double target) {
+    ++pivots;
+    auto const affected = rowsWith(nonBasicVar);
+    double const coeff = rows[basicVar].at(nonBasicVar);
+    // Move the non-basic variable so that the basic one gets to its target
+    double const diff = (target - values[basicVar]) / coeff;
+    values[nonBasicVar] += diff;
+    for (unsigned row : affected) {
+        values[row] += rows[row].at(nonBasicVar) * diff;
+    }
+    values[basicVar] = target;
+
+    // The row of the entering variable: nonBasicVar = 1/coeff basicVar - sum_{j != nonBasicVar} a_j/coeff x_j
+    std::unordered_map<unsigned, double> enteringRow;
+    enteringRow.emplace(basicVar, 1 / coeff);
+    for (auto const & term : rows[basicVar]) {
+        if (term.first != nonBasicVar) {
+            enteringRow.emplace(term.first, -term.second / coeff);
+        }
+    }
+    rows[basicVar].clear();
+    basic[basicVar] = false;
+    violated.erase(basicVar);
+    for (auto const & term : enteringRow) {
+        columns[term.first].push_back(nonBasicVar);
+    }
+    // Substitute the entering variable in the other rows
+    for (unsigned row : affected) {
+        if (row == basicVar) { continue; }
+        auto & poly = rows[row];
+        double const factor = poly.at(nonBasicVar);
+        poly.erase(nonBasicVar);
+        for (auto const & term : enteringRow) {
+            auto it = poly.find(term.first);
+            if (it == poly.end()) {
+                poly.emplace(term.first, factor * term.second);
+                columns[term.first].push_back(row);
+            } else {
+                it->second += factor * term.second;
+                if (std::fabs(it->second) < minimalPivot) {
+                    poly.erase(it);
+                }
+            }
+        }
+        updateViolated(row);
+    }
+    rows[nonBasicVar] = std::move(enteringRow);
+    basic[nonBasicVar] = true;
+    columns[nonBasicVar].clear();
+    updateViolated(nonBasicVar);
+}
@@ -0,0 +1,57 @@
+#ifndef OPENSMT_FLOATSIMPLEX_H
+#define OPENSMT_FLOATSIMPLEX_H
+
+#include <cstddef>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A Simplex in double precision over a copy of the tableau.  It is used to guess a feasible basis that the exact
+ * Simplex then re-establishes and verifies in rationals; nothing it computes is trusted as such.
+ *
+ * The variables are identified by their ids.  Each row defines a basic variable as a sum of non-basic variables.
+ * Values and bounds are compared with a relative tolerance, and pivots on coefficients close to zero are avoided.
+ */
+class FloatSimplex {
+public:
+    struct Term { unsigned var; double coeff; };
+
+    void addVar(unsigned var, double value);
+    void setLowerBound(unsigned var, double bound);
+    void setUpperBound(unsigned var, double bound);
+    void addRow(unsigned basicVar, std::vector<Term> const & terms);
+
+    // Pivot until the bounds of all the basic variables hold or no pivot is possible.  Returns true if the bounds hold.
+    bool run(std::size_t maxPivots);
+
+    bool isBasic(unsigned var) const { return var < basic.size() and basic[var]; }
+    double getValue(unsigned var) const { return values[var]; }
+    bool isCloseTo(double value, double bound) const;
+    std::size_t getNumOfPivots() const { return pivots; }
+
+private:
+    static constexpr double tolerance = 1e-9;
+    static constexpr double minimalPivot = 1e-11;
+
+    std::vector<double> values;
+    std::vector<double> lower;
+    std::vector<double> upper;
+    std::vector<bool> hasLower;
+    std::vector<bool> hasUpper;
+    std::vector<bool> basic;
+    std::vector<std::unordered_map<unsigned, double>> rows;
+    std::vector<std::vector<unsigned>> columns;  // May contain rows that no longer have the variable, and duplicates
+    std::vector<std::size_t> visited;            // Stamps for removing duplicates when walking a column
+    std::size_t stamp = 0;
+    std::set<unsigned> violated;                 // Basic variables out of their bounds, the smallest id is fixed first
+    std::size_t pivots = 0;
+
+    bool belowLower(unsigned var) const { return hasLower[var] and values[var] < lower[var] and not isCloseTo(values[var], lower[var]); }
+    bool aboveUpper(unsigned var) const { return hasUpper[var] and values[var] > upper[var] and not isCloseTo(values[var], upper[var]); }
+    void updateViolated(unsigned var);
+    std::vector<unsigned> rowsWith(unsigned nonBasicVar);
+    void pivot(unsigned basicVar, unsigned nonBasicVar, double target);
+};
+
+#endif //OPENSMT_FLOATSIMPLEX_H
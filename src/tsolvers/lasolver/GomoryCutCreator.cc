@@ -0,0 +1,60 @@
+#include "GomoryCutCreator.h"
+
+#include <cassert>
+#include <cmath>
+
+using opensmt::Real;
+
+namespace {
+Real fractionalPart(Real const & r) { return r - r.floor(); }
+}
+
+std::optional<GomoryCutCreator::Cut> GomoryCutCreator::makeCut(Real const & basicValue, std::vector<RowTerm> const & row) {
+    Real const f0 = fractionalPart(basicValue);
+    if (f0.isZero()) { return std::nullopt; }
+    Real const oneMinusF0 = Real(1) - f0;
+
+    // Substituting x_j = l_j + y_j for the variables at a lower bound and x_j = u_j - y_j for those at an upper bound
+    // gives the row x + sum a'_j y_j = basicValue with y_j >= 0, from which the cut sum c_j y_j >= 1 follows.
+    Cut cut;
+    cut.rhs = 1;
+    double squaredNorm = 0;
+    bool allIntegers = true;
+    for (RowTerm const & term : row) {
+        Real const a = term.atUpper ? term.coeff : -term.coeff;
+        Real c;
+        if (term.isInteger) {
+            assert(term.bound.isInteger());
+            Real const fj = fractionalPart(a);
+            c = fj <= f0 ? fj / f0 : (Real(1) - fj) / oneMinusF0;
+        } else {
+            allIntegers = false;
+            c = a >= 0 ? a / f0 : -a / oneMinusF0;
+        }
+        if (c.isZero()) { continue; }
+        squaredNorm += c.get_d() * c.get_d();
+        // c y_j is c x_j - c l_j at a lower bound and c u_j - c x_j at an upper bound
+        if (term.atUpper) {
+            cut.rhs -= c * term.bound;
+            cut.terms.emplace_back(term.var, -c);
+        } else {
+            cut.rhs += c * term.bound;
+            cut.terms.emplace_back(term.var, c);
+        }
+    }
+    if (cut.terms.empty()) { return std::nullopt; }
+    // The current vertex has y = 0, so the violation of the cut is 1
+    cut.efficacy = 1 / std::sqrt(squaredNorm);
+
+    if (allIntegers) {
+        Real multiplier = 1;
+        for (auto const & term : cut.terms) {
+            multiplier = lcm(multiplier, term.second.get_den());
+        }
+        for (auto & term : cut.terms) {
+            term.second *= multiplier;
+        }
+        cut.rhs = (cut.rhs * multiplier).ceil();
+    }
+    return cut;
+}
@@ -0,0 +1,42 @@
+#ifndef OPENSMT_GOMORYCUTCREATOR_H
+#define OPENSMT_GOMORYCUTCREATOR_H
+
+#include "LARefs.h"
+#include "Real.h"
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * Gomory mixed-integer cuts from the rows of the final Simplex tableau.
+ *
+ * The row x = sum a_j x_j of a basic integer variable x with a fractional value gives a cut if every non-basic variable
+ * x_j is at one of its bounds.  The cut is violated by the current vertex but holds in every solution where x and the
+ * integer non-basic variables are integers and the non-basic variables are within these bounds.
+ */
+class GomoryCutCreator {
+public:
+    // A non-basic variable of the row with its coefficient and the bound it is at
+    struct RowTerm {
+        LVRef var;
+        opensmt::Real coeff;
+        opensmt::Real bound;
+        bool atUpper;
+        bool isInteger;
+    };
+
+    // The inequality sum coeff * var >= rhs.  A positive coefficient means that the cut depends on the lower bound of
+    // the variable, a negative one that it depends on the upper bound.
+    struct Cut {
+        std::vector<std::pair<LVRef, opensmt::Real>> terms;
+        opensmt::Real rhs;
+        double efficacy;    // The Euclidean distance of the current vertex from the cut, before scaling
+    };
+
+    // The cut from the row of a basic integer variable with the given fractional value.  If all the variables of the row
+    // are integers, the cut is scaled to integer coefficients and the right-hand side is rounded up.
+    static std::optional<Cut> makeCut(opensmt::Real const & basicValue, std::vector<RowTerm> const & row);
+};
+
+#endif //OPENSMT_GOMORYCUTCREATOR_H
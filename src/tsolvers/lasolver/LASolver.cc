@@ -12,8 +12,11 @@
 #include "ModelBuilder.h"
 #include "LIAInterpolator.h"
 #include "CutCreator.h"
+#include "GomoryCutCreator.h"
 #include "Random.h"
 
+#include <algorithm>
+#include <cmath>
 #include <unordered_set>
 
 static SolverDescr descr_la_solver("LA Solver", "Solver for Quantifier Free Linear Arithmetics");
@@ -106,6 +109,9 @@ LASolver::LASolver(SolverDescr dls, SMTConfig & c, ArithLogic & l)
 {
     dec_limit.push(0);
     status = INIT;
+    simplex.setBoundRefinementRowSize(std::max(0, c.lra_poly_deduct_size));
+    simplex.setFloatingPointGuide(c.lra_float_simplex());
+    simplex.setConflictRelaxationLimit(std::max(0, c.lra_relax_conflicts()));
 }
 
 
@@ -121,13 +127,21 @@ void LASolver::pushDecision(PtAsgn asgn)
 
 void LASolver::clearSolver()
 {
-    status = INIT;
-    simplex.clear();
     decision_trace.clear();
     int_decisions.clear();
     dec_limit.clear();
     TSolver::clearSolver();
+    rowDeductionReasons.clear();
+    gomoryCuts.clear();
 
+    if (status != INIT) {
+        // The atoms stay in the SAT solver also when their frame is popped.  Keep the variables, the tableau with its
+        // basis and the last consistent assignment for the next check; the atoms declared again are already known, and
+        // the new ones are added on the fly.  All the bounds have been retracted by the backtracking to level 0.
+        status = SAT;
+        return;
+    }
+    simplex.clear();
     laVarStore.clear();
     laVarMapper.clear();
     boundStore.clear();
@@ -136,6 +150,7 @@ void LASolver::clearSolver()
 
     int_vars.clear();
     int_vars_map.clear();
+    gomoryCutTerms.clear();
     // TODO: clear statistics
 //    this->egraphStats.clear();
 }
@@ -160,8 +175,10 @@ bool LASolver::check_simplex(bool complete) {
     }
     storeExplanation(simplex.checkSimplex());
 
-    if (explanation.size() == 0)
+    if (explanation.size() == 0) {
         setStatus(SAT);
+        getRowDeductions();
+    }
     else {
         setStatus(UNSAT);
     }
@@ -385,6 +402,13 @@ TRes LASolver::checkIntegersAndSplit() {
         }
     }
 
+    if (shouldTryGomoryCuts()) {
+        auto res = addGomoryCuts(varsToFix);
+        if (res != TRes::UNKNOWN) {
+            return res;
+        }
+    }
+
     LVRef chosen = splitOnRandom(varsToFix);
 
     assert(chosen != LVRef::Undef);
@@ -657,9 +681,49 @@ void LASolver::deduce(LABoundRef bound_prop) {
     PtAsgn ba = getAsgnByBound(bound_prop);
     if (!hasPolarity(ba.tr)) {
         storeDeduction(PtAsgn_reason(ba.tr, ba.sgn, PTRef_Undef));
+        rowDeductionReasons.erase(ba.tr);
+    }
+}
+
+void LASolver::getRowDeductions()
+{
+    for (auto const & implication : simplex.takeBoundImplications()) {
+        std::vector<PtAsgn> reason;
+        for (auto const & term : implication.explanation) {
+            reason.push_back(getAsgnByBound(term.boundref));
+        }
+        for (LABoundRef implied : implication.implied) {
+            PtAsgn ba = getAsgnByBound(implied);
+            if (!hasPolarity(ba.tr)) {
+                storeDeduction(PtAsgn_reason(ba.tr, ba.sgn, PTRef_Undef));
+                rowDeductionReasons[ba.tr] = reason;
+            }
+        }
     }
 }
 
+vec<PtAsgn> LASolver::getReasonFor(PtAsgn lit) {
+    auto it = rowDeductionReasons.find(lit.tr);
+    if (it == rowDeductionReasons.end()) {
+        return TSolver::getReasonFor(lit);
+    }
+    // The deduced literal is part of the conflict with its polarity negated
+    vec<PtAsgn> conflict;
+    conflict.push(PtAsgn(lit.tr, lit.sgn == l_True ? l_False : l_True));
+    for (PtAsgn asgn : it->second) {
+        conflict.push(asgn);
+    }
+#ifdef STATISTICS
+    if (conflict.size() > generalTSolverStats.max_reas_size)
+        generalTSolverStats.max_reas_size = conflict.size();
+    if (conflict.size() < generalTSolverStats.min_reas_size)
+        generalTSolverStats.min_reas_size = conflict.size();
+    generalTSolverStats.reasons_sent ++;
+    generalTSolverStats.avg_reas_size += conflict.size();
+#endif // STATISTICS
+    return conflict;
+}
+
 
 void LASolver::getConflict(vec<PtAsgn> & conflict) {
     for (PtAsgn lit : explanation) {
@@ -792,6 +856,25 @@ lbool LASolver::getPolaritySuggestion(PTRef ptref) const {
     return simplex.getPolaritySuggestion(var, bounds.pos, bounds.neg);
 }
 
+std::optional<Delta> LASolver::getInterfaceValue(PTRef var) const {
+    if (logic.isNumConst(var)) {
+        return Delta(logic.getNumConst(var));
+    }
+    if (not logic.isNumVar(var) or not laVarMapper.hasVar(var)) { // LASolver does not have any constraints on this LA var
+        return std::nullopt;
+    }
+    return simplex.getValuation(getVarForTerm(var));
+}
+
+lbool LASolver::getInterfaceEqualitySuggestion(PTRef eq) const {
+    assert(logic.isNumEq(eq));
+    Pterm const & term = logic.getPterm(eq);
+    auto lhsValue = getInterfaceValue(term[0]);
+    auto rhsValue = getInterfaceValue(term[1]);
+    if (not lhsValue or not rhsValue) { return l_Undef; }
+    return *lhsValue == *rhsValue ? l_True : l_False;
+}
+
 TRes LASolver::check(bool complete) {
     bool rval = check_simplex(complete);
     if (complete && rval) {
@@ -843,10 +926,9 @@ void LASolver::printStatistics(std::ostream & out) {
     laSolverStats.printStatistics(out);
 }
 
-bool LASolver::shouldTryCutFromProof() const {
+bool LASolver::shouldTryCutFromProof() {
     if (this->config.produce_inter()) { return false; }
-    static unsigned long counter = 0;
-    return ++counter % 10 == 0;
+    return ++cutFromProofCounter % 10 == 0;
 }
 
 namespace {
@@ -981,6 +1063,95 @@ TRes LASolver::cutFromProof() {
     return TRes::SAT;
 }
 
+bool LASolver::shouldTryGomoryCuts() {
+    if (this->config.produce_inter() or this->config.lia_gomory_cuts() <= 0) { return false; }
+    return ++gomoryCutCounter % gomoryCutPeriod == 0;
+}
+
+void LASolver::ageGomoryCuts() {
+    auto isBinding = [this](PTRef atom) {
+        if (not isInformed(atom)) { return false; }
+        LVRef var = getVarForLeq(atom);
+        return (simplex.hasLBound(var) and not simplex.isModelStrictlyOverLowerBound(var))
+            or (simplex.hasUBound(var) and not simplex.isModelStrictlyUnderUpperBound(var));
+    };
+    for (GomoryCut & cut : gomoryCuts) {
+        cut.age = isBinding(cut.atom) ? 0 : cut.age + 1;
+    }
+    gomoryCuts.erase(std::remove_if(gomoryCuts.begin(), gomoryCuts.end(), [](GomoryCut const & cut) { return cut.age > maxGomoryCutAge; }),
+                     gomoryCuts.end());
+}
+
+/*
+ * Adds Gomory cuts from the rows of the basic integer variables with fractional values.  A cut depends on the bounds
+ * of the non-basic variables of its row, so it is added as the clause (not b_1 or ... or not b_n or cut).  The cuts
+ * furthest from the current solution are selected.  Rows with the variables of earlier cuts are not used, so all the
+ * cuts are derived from the rows of the problem and the branches.
+ */
+TRes LASolver::addGomoryCuts(vec<LVRef> const & varsToFix) {
+    ageGomoryCuts();
+    std::size_t const budget = std::min<std::size_t>(config.lia_gomory_cuts(), maxLiveGomoryCuts - std::min(maxLiveGomoryCuts, gomoryCuts.size()));
+    if (budget == 0) { return TRes::UNKNOWN; }
+
+    std::vector<GomoryCutCreator::Cut> candidates;
+    std::vector<GomoryCutCreator::RowTerm> row;
+    for (LVRef x : varsToFix) {
+        if (not simplex.isBasic(x)) { continue; }
+        Delta const & value = simplex.getValuation(x);
+        if (value.hasDelta()) { continue; }
+        row.clear();
+        bool atBounds = true;
+        for (auto const & term : simplex.getRowPoly(x)) {
+            bool const atLower = simplex.hasLBound(term.var) and not simplex.isModelStrictlyOverLowerBound(term.var);
+            bool const atUpper = simplex.hasUBound(term.var) and not simplex.isModelStrictlyUnderUpperBound(term.var);
+            if (not atLower and not atUpper) { atBounds = false; break; }
+            Delta const & bound = atLower ? simplex.Lb(term.var) : simplex.Ub(term.var);
+            if (bound.hasDelta() or not isIntVar(term.var) or gomoryCutTerms.count(getVarPTRef(term.var)) > 0) { atBounds = false; break; }
+            row.push_back({term.var, term.coeff, bound.R(), not atLower, true});
+        }
+        if (not atBounds) { continue; }
+        auto cut = GomoryCutCreator::makeCut(value.R(), row);
+        if (not cut) { continue; }
+        // Cuts with large coefficients or coefficients of very different magnitudes are weak and make the arithmetic
+        // expensive
+        auto [minIt, maxIt] = std::minmax_element(cut->terms.begin(), cut->terms.end(), [](auto const & a, auto const & b) { return cmpabs(a.second, b.second) < 0; });
+        double const maxCoeff = std::fabs(maxIt->second.get_d());
+        if (maxCoeff > maxGomoryCutCoefficient or maxCoeff / std::fabs(minIt->second.get_d()) > maxGomoryCutDynamism) { continue; }
+        candidates.push_back(std::move(*cut));
+    }
+    std::sort(candidates.begin(), candidates.end(), [](auto const & a, auto const & b) { return a.efficacy > b.efficacy; });
+
+    std::unordered_set<PTRef, PTRefHash> added;
+    for (auto const & cut : candidates) {
+        if (added.size() == budget) { break; }
+        vec<PTRef> sum;
+        vec<PTRef> clause;
+        for (auto const & [var, coeff] : cut.terms) {
+            sum.push(logic.mkTimes(getVarPTRef(var), logic.mkIntConst(coeff)));
+            PtAsgn bound = getAsgnByBound(isPositive(coeff) ? simplex.readLBoundRef(var) : simplex.readUBoundRef(var));
+            clause.push(bound.sgn == l_True ? logic.mkNot(bound.tr) : bound.tr);
+        }
+        PTRef cutTerm = logic.mkGeq(logic.mkPlus(std::move(sum)), logic.mkIntConst(cut.rhs));
+        PTRef atom = logic.isNot(cutTerm) ? logic.getPterm(cutTerm)[0] : cutTerm;
+        // An assigned atom would make the clause false in the current assignment, which a split cannot be
+        if (hasPolarity(atom)) { continue; }
+        clause.push(cutTerm);
+        PTRef split = logic.mkOr(std::move(clause));
+        if (not logic.isOr(split) or added.count(split) > 0) { continue; }
+        added.insert(split);
+        splitondemand.push(split);
+        gomoryCuts.push_back({atom, 0});
+        // The LA variable of the term may stand for its negation
+        PTRef cutSum = logic.leqToConstantAndTerm(atom).second;
+        gomoryCutTerms.insert(cutSum);
+        gomoryCutTerms.insert(logic.mkNeg(cutSum));
+        ++laSolverStats.num_gomory_cuts;
+    }
+    if (added.empty()) { return TRes::UNKNOWN; }
+    setStatus(NEWSPLIT);
+    return TRes::SAT;
+}
+
 vec<PTRef> LASolver::collectEqualitiesFor(vec<PTRef> const & vars, std::unordered_set<PTRef, PTRefHash> const & knownEqualities) {
     struct DeltaHash {
         std::size_t operator()(Delta const & d) const {
@@ -992,27 +1163,21 @@ vec<PTRef> LASolver::collectEqualitiesFor(vec<PTRef> const & vars, std::unordere
     vec<PTRef> equalities;
     std::unordered_map<Delta, vec<PTRef>, DeltaHash> eqClasses;
     for (PTRef var : vars) {
-        if (logic.isNumConst(var)) {
-            eqClasses[logic.getNumConst(var)].push(var);
-        } else {
-            assert(logic.isNumVar(var));
-            if (not laVarMapper.hasVar(var)) { // LASolver does not have any constraints on this LA var
-                continue;
-            }
-            LVRef v = laVarMapper.getVarByPTId(logic.getPterm(var).getId());
-            auto value = simplex.getValuation(v);
-            eqClasses[value].push(var);
+        assert(logic.isNumConst(var) or logic.isNumVar(var));
+        if (auto value = getInterfaceValue(var)) {
+            eqClasses[*value].push(var);
         }
     }
 
+    // Model-based combination: only the variables with the same value are proposed to be equal, and a chain through
+    // each class suffices for the other solver to derive the rest by transitivity.  A known equality of the chain is
+    // already assigned, and it is true since the values are equal.
     for (auto const & entry : eqClasses) {
         auto const & equivalentVars = entry.second;
-        for (int i = 0; i < equivalentVars.size(); ++i) {
-            for (int j = i + 1; j < equivalentVars.size(); ++j) {
-                PTRef eq = logic.mkEq(equivalentVars[i], equivalentVars[j]);
-                if (knownEqualities.find(eq) == knownEqualities.end()) {
-                    equalities.push(eq);
-                }
+        for (int i = 0; i + 1 < equivalentVars.size(); ++i) {
+            PTRef eq = logic.mkEq(equivalentVars[i], equivalentVars[i + 1]);
+            if (knownEqualities.find(eq) == knownEqualities.end()) {
+                equalities.push(eq);
             }
         }
     }
@@ -19,6 +19,7 @@
 #include "FarkasInterpolator.h"
 #include "LAVarMapper.h"
 
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -30,12 +31,14 @@ class LASolverStats
 {
     public:
         int num_vars;
+        int num_gomory_cuts;
         opensmt::OSMTTimeVal timer;
 
-        LASolverStats() : num_vars(0) {}
+        LASolverStats() : num_vars(0), num_gomory_cuts(0) {}
 
         void printStatistics(std::ostream& os) {
             os << "; Number of LA vars........: " << num_vars << '\n';
+            os << "; Gomory cuts..............: " << num_gomory_cuts << '\n';
             os << "; LA time..................: " << timer.getTime() << " s\n";
         }
 };
@@ -100,7 +103,7 @@ public:
 
     virtual void printStatistics(std::ostream &) override;
 
-    virtual void clearSolver() override; // Remove all problem specific data from the solver.  Should be called each time the solver is being used after a push or a pop in the incremental interface.
+    virtual void clearSolver() override; // Reset the search state.  Should be called each time the solver is being used after a push or a pop in the incremental interface; an initialized solver keeps its tableau and assignment.
 
     void getNewSplits(vec<PTRef>& splits) override;
     void  declareAtom        (PTRef tr) override;                // Inform the theory solver about the existence of an atom
@@ -111,6 +114,7 @@ public:
     void  popBacktrackPoint  ( ) override;                       // Backtrack to last saved point
     void  popBacktrackPoints ( unsigned int ) override;         // Backtrack given number of saved points
     lbool getPolaritySuggestion(PTRef) const;
+    lbool getInterfaceEqualitySuggestion(PTRef eq) const;    // The polarity of an interface equality in the current assignment
     vec<PTRef> collectEqualitiesFor(vec<PTRef> const & vars, std::unordered_set<PTRef, PTRefHash> const & knownEqualities) override;
 
     PTRef getRealInterpolant(const ipartitions_t &, std::map<PTRef, icolor_t>*, PartitionManager & pmanager);
@@ -118,6 +122,7 @@ public:
 
     // Return the conflicting bounds
     void getConflict(vec<PtAsgn> &) override;
+    vec<PtAsgn> getReasonFor(PtAsgn lit) override;
 
     ArithLogic& getLogic() override;
     bool        isValid(PTRef tr) override;
@@ -128,6 +133,19 @@ private:
     Map<LVRef, bool, LVRefHash> int_vars_map; // stores problem variables for duplicate check
     vec<LVRef> int_vars;                      // stores the list of problem variables without duplicates
     double seed = 123;
+    unsigned long cutFromProofCounter = 0; // How many times a cut from proof was considered
+
+    // The Gomory cuts added recently.  A cut ages in every round of cuts where it does not bind the current solution,
+    // and new cuts are only added while there are fewer than maxLiveGomoryCuts of them.
+    struct GomoryCut { PTRef atom; unsigned age; };
+    static constexpr unsigned gomoryCutPeriod = 2;          // Cuts are tried in every gomoryCutPeriod-th integer check
+    static constexpr unsigned maxGomoryCutAge = 8;
+    static constexpr std::size_t maxLiveGomoryCuts = 32;
+    static constexpr double maxGomoryCutDynamism = 1e6;     // The largest ratio of the coefficients of a selected cut
+    static constexpr double maxGomoryCutCoefficient = 1e4;  // The largest absolute coefficient of a selected cut
+    std::vector<GomoryCut> gomoryCuts;
+    std::unordered_set<PTRef, PTRefHash> gomoryCutTerms;    // The linear terms of all the cuts; their rows give no cuts
+    unsigned long gomoryCutCounter = 0;                     // How many times Gomory cuts were considered
 
     LABoundStore::BoundInfo addBound(PTRef leq_tr);
     void updateBound(PTRef leq_tr);
@@ -150,6 +168,7 @@ private:
     bool hasVar(PTRef expr);
     LVRef getVarForLeq(PTRef ref)  const;
     LVRef getVarForTerm(PTRef ref) const  { return laVarMapper.getVarByPTId(logic.getPterm(ref).getId()); }
+    std::optional<Delta> getInterfaceValue(PTRef var) const; // The value of a constant or a variable, if the solver knows it
     void notifyVar(LVRef);                             // Notify the solver of the existence of the var. This is so that LIA can add it to integer vars list.
 
     // Random splitting heuristic
@@ -157,10 +176,14 @@ private:
     TRes checkIntegersAndSplit();
     bool isModelInteger (LVRef v) const;
     TRes cutFromProof();
-    bool shouldTryCutFromProof() const;
+    bool shouldTryCutFromProof();
+    TRes addGomoryCuts(vec<LVRef> const & varsToFix);
+    bool shouldTryGomoryCuts();
+    void ageGomoryCuts();
 
     void getSuggestions( vec<PTRef>& dst, SolverId solver_id );                                   // find possible suggested atoms
     void getSimpleDeductions(LVRef v, LABoundRef);      // find deductions from actual bounds position
+    void getRowDeductions();                            // find deductions from the bounds implied by tableau rows
     unsigned getIteratorByPTRef( PTRef e, bool );                                                 // find bound iterator by the PTRef
     inline bool getStatus( );                               // Read the status of the solver in lbool
     bool setStatus( LASolverStatus );               // Sets and return status of the solver
@@ -171,6 +194,9 @@ private:
 
     std::vector<opensmt::Real> concrete_model;              // Save here the concrete model for the vars indexed by Id
 
+    // The reasons of the literals deduced from the rows, valid while the literals are deduced
+    std::unordered_map<PTRef, std::vector<PtAsgn>, PTRefHash> rowDeductionReasons;
+
     opensmt::Real evaluateTerm(PTRef tr);
 
     LASolverStatus status;                  // Internal status of the solver (different from bool)
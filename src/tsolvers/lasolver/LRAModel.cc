@@ -20,7 +20,6 @@ LRAModel::addVar(LVRef v)
 
     while (static_cast<unsigned>(current_assignment.size()) <= getVarId(v)) {
         current_assignment.emplace_back();
-        last_consistent_assignment.emplace_back();
         changed_vars_set.assure_domain(getVarId(v));
         int_lbounds.emplace_back();
         int_ubounds.emplace_back();
@@ -33,11 +32,11 @@ LRAModel::addVar(LVRef v)
 void
 LRAModel::write(const LVRef &v, Delta val)
 {
-    current_assignment[getVarId(v)] = std::move(val);
     if (!changed_vars_set.contains(getVarId(v))) {
         changed_vars_set.insert(getVarId(v));
-        changed_vars_vec.push(v);
+        undo_log.emplace_back(v, std::move(current_assignment[getVarId(v)]));
     }
+    current_assignment[getVarId(v)] = std::move(val);
 }
 
 
@@ -73,9 +72,8 @@ LRAModel::popBounds()
 
 void LRAModel::clear() {
     this->current_assignment.clear();
-    this->last_consistent_assignment.clear();
+    this->undo_log.clear();
     this->changed_vars_set.reset();
-    this->changed_vars_vec.clear();
     this->int_lbounds.clear();
     this->bound_trace.clear();
     this->has_model.clear();
@@ -6,6 +6,8 @@
 #define OPENSMT_LRAMODEL_H
 
 #include <cstdint>
+#include <utility>
+#include <vector>
 #include "Delta.h"
 #include "LABounds.h"
 #include "Vec.h"
@@ -26,9 +28,9 @@ protected:
     vec<LABoundRef> bound_trace;
 
     std::vector<Delta>  current_assignment;
-    std::vector<Delta>  last_consistent_assignment;
+    // The values the changed variables had in the last consistent assignment, at most one entry per variable
+    std::vector<std::pair<LVRef, Delta>> undo_log;
     nat_set     changed_vars_set;
-    vec<LVRef>  changed_vars_vec;
 
     LABoundStore &bs;
     int n_vars_with_model;
@@ -48,10 +50,9 @@ private:
     // needed from Simplex to make all work properly with backtracking and quasi-basic variables
     friend class Simplex;
     void         restoreVarWithValue(LVRef v, Delta val) {
-        current_assignment[getVarId(v)] = val;
-        last_consistent_assignment[getVarId(v)] = std::move(val);
+        assert(undo_log.empty());
+        current_assignment[getVarId(v)] = std::move(val);
     }
-    inline const Delta& readBackupValue (LVRef v) const { return last_consistent_assignment[getVarId(v)]; }
 public:
 
     void pushBound(const LABoundRef br);
@@ -61,6 +62,9 @@ public:
     bool hasUBound(LVRef v) const { return int_ubounds[getVarId(v)].size() != 0; }
     const LABound& readUBound(const LVRef &v) const;
     LABoundRef readUBoundRef(LVRef v) const;
+    // The active bounds of the variable, from the weakest to the strongest
+    vec<LABoundRef> const & getLBounds(LVRef v) const { return int_lbounds[getVarId(v)]; }
+    vec<LABoundRef> const & getUBounds(LVRef v) const { return int_ubounds[getVarId(v)]; }
     inline const Delta& Lb(LVRef v) const { return readLBound(v).getValue(); }
     inline const Delta& Ub(LVRef v) const { return readUBound(v).getValue(); }
     void pushBacktrackPoint();
@@ -73,20 +77,15 @@ public:
     bool boundTriviallyUnsatisfied(LVRef v, LABoundRef b) const;
 
     void saveAssignment() {
-        for (int i = 0; i < changed_vars_vec.size(); ++i) {
-            LVRef v = changed_vars_vec[i];
-            last_consistent_assignment[getVarId(v)] = current_assignment[getVarId(v)];
-        }
-        changed_vars_vec.clear();
+        undo_log.clear();
         changed_vars_set.reset();
     }
 
     void restoreAssignment() {
-        for (int i = 0; i < changed_vars_vec.size(); ++i) {
-            LVRef v = changed_vars_vec[i];
-            current_assignment[getVarId(v)] = last_consistent_assignment[getVarId(v)];
+        for (auto & [v, val] : undo_log) {
+            current_assignment[getVarId(v)] = std::move(val);
         }
-        changed_vars_vec.clear();
+        undo_log.clear();
         changed_vars_set.reset();
     }
 
@@ -11,78 +11,197 @@
 #include "Real.h"
 #include <vector>
 #include <unordered_map>
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
 
+/*
+ * A sparse polynomial over rationals.  The terms are kept ordered by variable num in two parallel arrays, the variables
+ * and the coefficients, which share a single allocation.  Walking the variables, as done when merging or looking up a
+ * term, does not touch the coefficients.  Iterating over the polynomial gives proxy terms with the fields `var` and
+ * `coeff`.
+ */
 template<typename VarType>
 class PolynomialT {
-private:
-    struct Term {
-        VarType var;
-        opensmt::Real coeff;
+    template<bool isConst>
+    class TermIterator {
+        using var_ptr = std::conditional_t<isConst, VarType const *, VarType *>;
+        using coeff_ref = std::conditional_t<isConst, opensmt::Real const &, opensmt::Real &>;
+        using coeff_ptr = std::conditional_t<isConst, opensmt::Real const *, opensmt::Real *>;
+        var_ptr var;
+        coeff_ptr coeff;
+    public:
+        struct Term {
+            VarType var;
+            coeff_ref coeff;
+        };
+        struct Arrow {
+            Term term;
+            Term const * operator->() const { return &term; }
+        };
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Term;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Arrow;
+        using reference = Term;
+
+        TermIterator(var_ptr var, coeff_ptr coeff) : var(var), coeff(coeff) {}
+        // A mutable iterator converts to a const one
+        template<bool otherConst, typename = std::enable_if_t<isConst and not otherConst>>
+        TermIterator(TermIterator<otherConst> const & other) : var(other.var), coeff(other.coeff) {}
 
-        Term(VarType var, opensmt::Real&& coeff): var{var.x}, coeff{std::move(coeff)} {}
+        Term operator*() const { return Term{*var, *coeff}; }
+        Arrow operator->() const { return Arrow{**this}; }
+        TermIterator & operator++() { ++var; ++coeff; return *this; }
+        TermIterator operator++(int) { TermIterator old = *this; ++*this; return old; }
+        bool operator==(TermIterator const & other) const { return var == other.var; }
+        bool operator!=(TermIterator const & other) const { return var != other.var; }
+
+        template<bool> friend class TermIterator;
+        friend class PolynomialT;
     };
-    struct TermCmp {
-        bool operator()(const Term& first, const Term& second) { return first.var.x < second.var.x; }
+
+    // The coefficients followed by the variables in one block of memory
+    class TermArrays {
+        void * block = nullptr;
+        std::size_t sz = 0;
+        std::size_t cap = 0;
+
+        void reallocate(std::size_t newCap) {
+            assert(newCap >= sz);
+            void * newBlock = newCap == 0 ? nullptr : ::operator new(newCap * (sizeof(opensmt::Real) + sizeof(VarType)));
+            auto newCoeffs = static_cast<opensmt::Real *>(newBlock);
+            auto newVars = reinterpret_cast<VarType *>(newCoeffs + newCap);
+            for (std::size_t i = 0; i < sz; ++i) {
+                new (newCoeffs + i) opensmt::Real(std::move(coeffs()[i]));
+                std::destroy_at(coeffs() + i);
+                newVars[i] = vars()[i];
+            }
+            ::operator delete(block);
+            block = newBlock;
+            cap = newCap;
+        }
+        void grow(std::size_t needed) { if (needed > cap) { reallocate(std::max(needed, 2 * cap)); } }
+    public:
+        TermArrays() = default;
+        TermArrays(TermArrays const & other) {
+            reallocate(other.sz);
+            for (std::size_t i = 0; i < other.sz; ++i) {
+                new (coeffs() + i) opensmt::Real(other.coeffs()[i]);
+                vars()[i] = other.vars()[i];
+            }
+            sz = other.sz;
+        }
+        TermArrays(TermArrays && other) noexcept { swap(other); }
+        TermArrays & operator=(TermArrays other) { swap(other); return *this; }
+        ~TermArrays() { resize(0); ::operator delete(block); }
+        void swap(TermArrays & other) noexcept {
+            std::swap(block, other.block);
+            std::swap(sz, other.sz);
+            std::swap(cap, other.cap);
+        }
+
+        std::size_t size() const { return sz; }
+        opensmt::Real * coeffs() { return static_cast<opensmt::Real *>(block); }
+        opensmt::Real const * coeffs() const { return static_cast<opensmt::Real const *>(block); }
+        VarType * vars() { return reinterpret_cast<VarType *>(coeffs() + cap); }
+        VarType const * vars() const { return reinterpret_cast<VarType const *>(coeffs() + cap); }
+
+        // New coefficients are zero, new variables are undefined
+        void resize(std::size_t newSize) {
+            grow(newSize);
+            for (std::size_t i = sz; i < newSize; ++i) {
+                new (coeffs() + i) opensmt::Real();
+                vars()[i] = VarType::Undef;
+            }
+            for (std::size_t i = newSize; i < sz; ++i) {
+                std::destroy_at(coeffs() + i);
+            }
+            sz = newSize;
+        }
+        void insert(std::size_t pos, VarType var, opensmt::Real && coeff) {
+            assert(pos <= sz);
+            resize(sz + 1);
+            for (std::size_t i = sz - 1; i > pos; --i) {
+                coeffs()[i] = std::move(coeffs()[i - 1]);
+                vars()[i] = vars()[i - 1];
+            }
+            coeffs()[pos] = std::move(coeff);
+            vars()[pos] = var;
+        }
+        void erase(std::size_t pos) {
+            assert(pos < sz);
+            for (std::size_t i = pos + 1; i < sz; ++i) {
+                coeffs()[i - 1] = std::move(coeffs()[i]);
+                vars()[i - 1] = vars()[i];
+            }
+            resize(sz - 1);
+        }
+        void shrinkToFit() { if (cap > sz) { reallocate(sz); } }
     };
-public:
-    using poly_t = std::vector<Term>; // Terms are ordered by variable num
-private:
-    poly_t poly;
+
+    TermArrays poly;
     using mergeFunctionInformerType = void(*)(VarType);
+
+    std::size_t position(VarType var) const {
+        auto it = std::lower_bound(poly.vars(), poly.vars() + poly.size(), var, [](VarType x, VarType y) { return x.x < y.x; });
+        return it - poly.vars();
+    }
 public:
     void addTerm(VarType var, opensmt::Real coeff);
     std::size_t size() const;
     const opensmt::Real & getCoeff(VarType var) const;
+    opensmt::Real const * tryGetCoeff(VarType var) const;
     opensmt::Real removeVar(VarType var);
     void negate();
     void divideBy(const opensmt::Real& r);
 
+    /* Adds `coeff` times `other` to this polynomial; the hooks are informed about the variables added and removed */
     template <typename ADD = mergeFunctionInformerType, typename REM = mergeFunctionInformerType>
     void merge(
         PolynomialT const & other,
         opensmt::Real const & coeff,
-        poly_t & tmp_storage,
         ADD informAdded = [](VarType){},
         REM informRemoved = [](VarType){}
     );
 
-    /* Simple version of merge that does not use the hooks and does not need external temporary storage */
-    void merge(PolynomialT const & other, opensmt::Real const & coeff) {
-        poly_t tmp_storage;
-        return merge(other, coeff, tmp_storage);
-    }
-
-    using iterator = typename poly_t::iterator;
-    using const_iterator = typename poly_t::const_iterator;
+    using iterator = TermIterator<false>;
+    using const_iterator = TermIterator<true>;
 
     iterator begin(){
-        return poly.begin();
+        return iterator(poly.vars(), poly.coeffs());
     }
     iterator end() {
-        return poly.end();
+        return iterator(poly.vars() + poly.size(), poly.coeffs() + poly.size());
     }
 
     const_iterator begin() const {
-        return poly.cbegin();
+        return const_iterator(poly.vars(), poly.coeffs());
     }
     const_iterator end() const{
-        return poly.cend();
+        return const_iterator(poly.vars() + poly.size(), poly.coeffs() + poly.size());
     }
 
     // debug
     bool contains(VarType var) const {
-        return findTermForVar(var) != poly.end();
+        return findTermForVar(var) != end();
     }
 
 
     const_iterator findTermForVar(VarType var) const {
-        return std::find_if(poly.begin(), poly.end(), [var](const Term& term) { return term.var == var; });
+        std::size_t pos = position(var);
+        if (pos == poly.size() or poly.vars()[pos].x != var.x) { return end(); }
+        return const_iterator(poly.vars() + pos, poly.coeffs() + pos);
     }
 
     iterator findTermForVar(VarType var) {
-        return std::find_if(poly.begin(), poly.end(), [var](const Term& term) { return term.var == var; });
+        std::size_t pos = position(var);
+        if (pos == poly.size() or poly.vars()[pos].x != var.x) { return end(); }
+        return iterator(poly.vars() + pos, poly.coeffs() + pos);
     }
 
     void print() const;
@@ -90,93 +209,100 @@ public:
 
 template<typename VarType>
 template<typename ADD, typename REM>
-void PolynomialT<VarType>::merge(PolynomialT<VarType> const & other, opensmt::Real const & coeff, poly_t & tmp_storage, ADD informAdded,
-                  REM informRemoved) {
-    if (tmp_storage.size() < this->poly.size() + other.poly.size()) {
-        tmp_storage.resize(this->poly.size() + other.poly.size(), Term(VarType::Undef, 0));
-    }
-    std::size_t storageIndex = 0;
-    auto myIt = std::make_move_iterator(poly.begin());
-    auto otherIt = other.poly.cbegin();
-    auto myEnd = std::make_move_iterator(poly.end());
-    auto otherEnd = other.poly.cend();
-    TermCmp cmp;
-    FastRational tmp;
-    while(true) {
-        if (myIt == myEnd) {
-            for (auto it = otherIt; it != otherEnd; ++it) {
-                tmp_storage[storageIndex].var = it->var;
-                multiplication(tmp_storage[storageIndex].coeff, it->coeff, coeff);
-                ++storageIndex;
-                informAdded(it->var);
+void PolynomialT<VarType>::merge(PolynomialT<VarType> const & other, opensmt::Real const & coeff, ADD informAdded, REM informRemoved) {
+    std::size_t const mySize = poly.size();
+    std::size_t const otherSize = other.poly.size();
+    VarType const * otherVars = other.poly.vars();
+    opensmt::Real const * otherCoeffs = other.poly.coeffs();
+    // First pass over the variables only: find the terms of `other` that are new in this polynomial
+    std::size_t added = 0;
+    {
+        VarType const * myVars = poly.vars();
+        for (std::size_t i = 0, j = 0; j < otherSize;) {
+            if (i == mySize or otherVars[j].x < myVars[i].x) {
+                informAdded(otherVars[j]);
+                ++added;
+                ++j;
+            } else if (myVars[i].x < otherVars[j].x) {
+                ++i;
+            } else {
+                ++i;
+                ++j;
             }
-            break;
-        }
-        if (otherIt == otherEnd) {
-            std::move(myIt, myEnd, tmp_storage.begin() + storageIndex);
-            storageIndex += myEnd - myIt;
-            break;
         }
-        if (cmp(*myIt, *otherIt)) {
-            tmp_storage[storageIndex] = *myIt;
-            ++storageIndex;
-            ++myIt;
-        }
-        else if (cmp(*otherIt, *myIt)) {
-            tmp_storage[storageIndex].var = otherIt->var;
-            multiplication(tmp_storage[storageIndex].coeff, otherIt->coeff, coeff);
-            ++storageIndex;
-            informAdded(otherIt->var);
-            ++otherIt;
+    }
+    // Second pass merges in place from the back.  The write position never falls behind the read position of this
+    // polynomial, so each of our coefficients is moved at most once.
+    std::size_t const total = mySize + added;
+    poly.resize(total);
+    VarType * myVars = poly.vars();
+    opensmt::Real * myCoeffs = poly.coeffs();
+    // Small coefficients are common in the tableau; merging with 1 or -1 does not need a multiplication
+    bool const isOne = coeff.isOne();
+    bool const isMinusOne = not isOne and coeff == -1;
+    FastRational tmp;
+    std::size_t write = total;
+    std::size_t i = mySize;
+    std::size_t j = otherSize;
+    auto keepMine = [&]() {
+        --write;
+        if (write != i) {
+            myVars[write] = myVars[i];
+            myCoeffs[write] = std::move(myCoeffs[i]);
         }
-        else {
-            assert(myIt->var == otherIt->var);
-            multiplication(tmp, otherIt->coeff, coeff);
-            myIt->coeff += tmp;
-            if (myIt->coeff.isZero()) {
-                informRemoved(myIt->var);
-            }
+    };
+    while (j > 0) {
+        if (i > 0 and otherVars[j - 1].x < myVars[i - 1].x) {
+            --i;
+            keepMine();
+        } else if (i == 0 or myVars[i - 1].x < otherVars[j - 1].x) {
+            --j;
+            --write;
+            myVars[write] = otherVars[j];
+            if (isOne) { myCoeffs[write] = otherCoeffs[j]; }
+            else if (isMinusOne) { myCoeffs[write] = otherCoeffs[j]; myCoeffs[write].negate(); }
+            else { multiplication(myCoeffs[write], otherCoeffs[j], coeff); }
+        } else {
+            --i;
+            --j;
+            auto & myCoeff = myCoeffs[i];
+            if (isOne) { myCoeff += otherCoeffs[j]; }
+            else if (isMinusOne) { myCoeff -= otherCoeffs[j]; }
             else {
-                tmp_storage[storageIndex] = *myIt;
-                ++storageIndex;
+                multiplication(tmp, otherCoeffs[j], coeff);
+                myCoeff += tmp;
+            }
+            if (myCoeff.isZero()) {
+                informRemoved(myVars[i]);
+            } else {
+                keepMine();
             }
-            ++myIt;
-            ++otherIt;
         }
     }
-    // At this point the right elements are in `tmp_storage`, from beginning to the `storageIndex`.
-    // We need to get these elements to `this->poly`. Note that we never change the `tmp_storage` container, we just move out
-    // the appropriate elements.
-    // However, we observed that we need to shrink `poly` if its size is much smaller than the capacity.
-    // The reason is that keeping large free capacity around for many rows blows up the memory
-    // (worse case quadratic in the size of the tableau).
-    auto polySize = poly.size();
-    if (storageIndex > polySize) {
-        // In this case we have more elements to move than the current size of the `poly` container.
-        // We move the elements that fit the current `poly` size and then we insert the rest of the elements.
-        std::move(tmp_storage.begin(), tmp_storage.begin() + polySize, poly.begin());
-        poly.insert(poly.end(), std::make_move_iterator(tmp_storage.begin() + polySize), std::make_move_iterator(tmp_storage.begin() + storageIndex));
-    }
-    else if (/*storageIndex <= poly.size() and */ polySize <= 2 * storageIndex) {
-        // In this case we have less elements that need to move than what we currently already have in `poly`, but not too litle.
-        // We just move the appropriate elements and destroy the excess elements of `poly`.
-        // Since we are removing too many elements, we avoid shrinking which would require re-allocation.
-        std::move(tmp_storage.begin(), tmp_storage.begin() + storageIndex, poly.begin());
-        poly.erase(poly.begin() + storageIndex, poly.end());
-    } else { // poly.size() > 2 * storageIndex
-        // This case is similar to case 2, but we have much less elements in the result than currently in `poly`.
-        // To avoid too large free capacity in `poly`, we shrink its capacity to exactly the number of elements.
-        // It is basically `poly.shrink_to_fit()`, except that `shrink_to_fit` is non-binding.
-        std::vector<Term>(std::make_move_iterator(tmp_storage.begin()), std::make_move_iterator(tmp_storage.begin() + storageIndex)).swap(poly);
+    if (write == i) { return; } // Nothing cancelled out, the remaining terms are in place
+    while (i > 0) {
+        --i;
+        keepMine();
+    }
+    // The terms that cancelled out left a gap of `write` elements at the front
+    std::size_t const resultSize = total - write;
+    for (std::size_t k = 0; k < resultSize; ++k) {
+        myVars[k] = myVars[write + k];
+        myCoeffs[k] = std::move(myCoeffs[write + k]);
+    }
+    poly.resize(resultSize);
+    if (mySize > 2 * resultSize) {
+        // We observed that keeping large free capacity around for many rows blows up the memory (worst case quadratic
+        // in the size of the tableau).  If the result is much smaller than the original polynomial, we shrink the
+        // capacity to exactly the number of elements.
+        poly.shrinkToFit();
     }
 }
 
 template<typename VarType>
 void PolynomialT<VarType>::addTerm(VarType var, opensmt::Real coeff) {
     assert(!contains(var));
-    Term term {var, std::move(coeff)};
-    auto it = std::upper_bound(poly.begin(), poly.end(), term, TermCmp{});
-    poly.insert(it, std::move(term));
+    poly.insert(position(var), var, std::move(coeff));
 }
 
 template<typename VarType>
@@ -187,34 +313,40 @@ unsigned long PolynomialT<VarType>::size() const {
 template<typename VarType>
 const FastRational &PolynomialT<VarType>::getCoeff(VarType var) const {
     assert(contains(var));
-    return findTermForVar(var)->coeff;
+    return poly.coeffs()[position(var)];
+}
+
+template<typename VarType>
+FastRational const * PolynomialT<VarType>::tryGetCoeff(VarType var) const {
+    std::size_t pos = position(var);
+    return pos < poly.size() and poly.vars()[pos].x == var.x ? &poly.coeffs()[pos] : nullptr;
 }
 
 template<typename VarType>
 opensmt::Real PolynomialT<VarType>::removeVar(VarType var) {
     assert(contains(var));
-    iterator it = findTermForVar(var);
-    auto coeff = std::move(it->coeff);
-    poly.erase(it);
+    std::size_t pos = position(var);
+    auto coeff = std::move(poly.coeffs()[pos]);
+    poly.erase(pos);
     return coeff;
 }
 
 template<typename VarType>
 void PolynomialT<VarType>::negate() {
-    for(auto & term : poly) {
-        term.coeff.negate();
+    for (std::size_t i = 0; i < poly.size(); ++i) {
+        poly.coeffs()[i].negate();
     }
 }
 
 template<typename VarType>
 void PolynomialT<VarType>::divideBy(const opensmt::Real &r) {
-    for(auto & term : poly) {
-        term.coeff /= r;
+    for (std::size_t i = 0; i < poly.size(); ++i) {
+        poly.coeffs()[i] /= r;
     }
 }
 template<typename VarType>
 void PolynomialT<VarType>::print() const {
-    for (auto & term : poly) {
+    for (auto term : *this) {
         std::cout << term.coeff << " * " << term.var.x << "v + ";
     }
     std::cout << std::endl;
@@ -4,6 +4,7 @@
 
 #include "Simplex.h"
 
+#include "FloatSimplex.h"
 #include "OsmtInternalException.h"
 
 #include <limits>
@@ -30,7 +31,10 @@ namespace{
 
 Simplex::Explanation Simplex::checkSimplex() {
     processBufferOfActivatedBounds();
-    bool bland_rule = false;
+    setBlandRule(false);
+    if (floatingPointGuide and not candidates.empty()) {
+        guessBasisInFloatingPoint();
+    }
     unsigned repeats = 0;
 
     // keep doing pivotAndUpdate until the SAT/UNSAT status is confirmed
@@ -38,15 +42,14 @@ Simplex::Explanation Simplex::checkSimplex() {
         repeats++;
         LVRef x = LVRef::Undef;
 
-        if (!bland_rule && (repeats > tableau.getNumOfCols()))
-            bland_rule = true;
+        if (!blandRule && (repeats > tableau.getNumOfCols()))
+            setBlandRule(true);
 
-        if (bland_rule) {
-            x = getBasicVarToFixByBland();
+        x = getBasicVarToFix();
+        if (blandRule) {
             ++simplex_stats.num_bland_ops;
         }
         else {
-            x = getBasicVarToFixByShortestPoly();
             ++simplex_stats.num_pivot_ops;
         }
 
@@ -58,7 +61,7 @@ Simplex::Explanation Simplex::checkSimplex() {
         }
 
         LVRef y_found = LVRef::Undef;
-        if (bland_rule){
+        if (blandRule){
             y_found = findNonBasicForPivotByBland(x);
         }
         else{
@@ -94,41 +97,26 @@ bool Simplex::isUnbounded(LVRef v) const {
     return model->isUnbounded(v);
 }
 
-LVRef Simplex::getBasicVarToFixByShortestPoly() const {
-    assert(std::all_of(candidates.begin(), candidates.end(),
-                       [&](LVRef var) {
-                           return var != LVRef::Undef && tableau.isBasic(var) && isModelOutOfBounds(var);
-                       }));
-    // MB: replace this with std::min_element when ranges are available (to avoid duplicate calls to getPolySize)
-    LVRef current = LVRef::Undef;
-    std::size_t current_poly_size = std::numeric_limits<std::size_t>::max();
-    for (auto it : candidates) { // Select the var with smallest row
-        bool const doUpdate = tableau.getPolySize(it) < current_poly_size;
-        if (doUpdate) {
-            current = it;
-            current_poly_size = tableau.getPolySize(it);
-        }
-    }
-    return current;
+LVRef Simplex::getBasicVarToFix() const {
+    assert([&]() {
+        for (int i = 0; i < candidates.size(); i++) {
+            LVRef var {static_cast<uint32_t>(candidates[i])};
+            if (not tableau.isBasic(var) or not isModelOutOfBounds(var)) { return false; }
+        }
+        return true;
+    }());
+    return candidates.empty() ? LVRef::Undef : LVRef{static_cast<uint32_t>(candidates[0])};
 }
 
-LVRef Simplex::getBasicVarToFixByBland() const {
-    assert(std::all_of(candidates.begin(), candidates.end(),
-                       [&](LVRef var) {
-                           return var != LVRef::Undef && tableau.isBasic(var) && isModelOutOfBounds(var);
-                       }));
-    // MB: replace this with std::min_element when ranges are available (to avoid duplicate calls to getVarId)
-    auto curr_var_id_x = std::numeric_limits<unsigned>::max();
-    LVRef current = LVRef::Undef;
-    for (auto it : candidates) { // Select the var with the smallest id
-        auto const id = getVarId(it);
-        bool const doUpdate = id < curr_var_id_x;
-        if (doUpdate) {
-            current = it;
-            curr_var_id_x = id;
-        }
-    }
-    return current;
+void Simplex::setBlandRule(bool bland) {
+    if (bland == blandRule) { return; }
+    blandRule = bland;
+    // The order of the candidates changes with the rule
+    vec<int> queued;
+    for (int i = 0; i < candidates.size(); i++) {
+        queued.push(candidates[i]);
+    }
+    candidates.build(queued);
 }
 
 LVRef Simplex::findNonBasicForPivotByHeuristic(LVRef basicVar) {
@@ -238,7 +226,9 @@ Simplex::Explanation Simplex::assertBoundOnVar(LVRef it, LABoundRef itBound_ref)
         const LABound & itBound = boundStore[itBound_ref];
         assert(itBound.getType() == bound_u || itBound.getType() == bound_l);
         LABoundRef br = itBound.getType() == bound_u ? model->readLBoundRef(it) : model->readUBoundRef(it);
-        return {{br, 1}, {itBound_ref, 1}};
+        Explanation expl {{br, 1}, {itBound_ref, 1}};
+        if (conflictRelaxationLimit >= expl.size()) { relaxConflictingBounds(expl); }
+        return expl;
     }
 
     // Here we count the bound as activated
@@ -255,11 +245,24 @@ Simplex::Explanation Simplex::assertBoundOnVar(LVRef it, LABoundRef itBound_ref)
 
 void Simplex::newCandidate(LVRef candidateVar) {
     assert(tableau.isBasic(candidateVar));
-    candidates.insert(candidateVar);
+    auto const id = getVarId(candidateVar);
+    if (id >= candidateRowSize.size()) {
+        candidateRowSize.resize(id + 1);
+    }
+    auto const rowSize = tableau.getPolySize(candidateVar);
+    if (not candidates.inHeap(id)) {
+        candidateRowSize[id] = rowSize;
+        candidates.insert(id);
+    } else if (candidateRowSize[id] != rowSize) {
+        candidateRowSize[id] = rowSize;
+        candidates.update(id);
+    }
 }
 
 void Simplex::eraseCandidate(LVRef candidateVar) {
-    candidates.erase(candidateVar);
+    if (candidates.inHeap(getVarId(candidateVar))) {
+        candidates.remove(getVarId(candidateVar));
+    }
 }
 
 
@@ -269,9 +272,21 @@ void Simplex::pivot(const LVRef bv, const LVRef nv){
     simplex_assert(valueConsistent(bv));
 //    tableau.print();
     updateValues(bv, nv);
+    changeBasis(bv, nv);
+}
+
+void Simplex::changeBasis(const LVRef bv, const LVRef nv) {
+    assert(tableau.isBasic(bv));
+    assert(tableau.isNonBasic(nv));
     tableau.pivot(bv, nv);
     // after pivot, bv is not longer a candidate
     eraseCandidate(bv);
+    // the rows bv was substituted into changed their size
+    for (LVRef row : tableau.getColumn(bv)) {
+        if (tableau.isBasic(row) and candidates.inHeap(getVarId(row))) {
+            newCandidate(row);
+        }
+    }
     // and nv can be a candidate
     if (getNumOfBoundsActive(nv) == 0) {
         tableau.basicToQuasi(nv);
@@ -286,6 +301,193 @@ void Simplex::pivot(const LVRef bv, const LVRef nv){
     simplex_assert(checkValueConsistency());
 }
 
+void Simplex::storeDefinition(LVRef row, Tableau::Polynomial const & poly) {
+    if (poly.size() > refinementRowSize) { return; }
+    auto const index = static_cast<unsigned>(definitions.size());
+    definitions.emplace_back();
+    auto & definition = definitions.back();
+    definition.reserve(poly.size() + 1);
+    definition.push_back({row, Real(-1)});
+    for (auto const & term : poly) {
+        definition.push_back({term.var, term.coeff});
+    }
+    for (auto const & term : definition) {
+        if (getVarId(term.var) >= occurrences.size()) {
+            occurrences.resize(getVarId(term.var) + 1);
+        }
+        occurrences[getVarId(term.var)].push_back(index);
+    }
+}
+
+void Simplex::refineBounds() {
+    boundImplications.clear();
+    if (touchedVars.empty()) { return; }
+    std::vector<unsigned> queued;
+    for (LVRef var : touchedVars) {
+        if (getVarId(var) >= occurrences.size()) { continue; }
+        for (unsigned index : occurrences[getVarId(var)]) {
+            if (queued.size() >= refinementRowBudget) { break; }
+            if (index >= definitionQueued.size()) {
+                definitionQueued.resize(definitions.size(), false);
+            }
+            if (not definitionQueued[index]) {
+                definitionQueued[index] = true;
+                queued.push_back(index);
+            }
+        }
+    }
+    touchedVars.clear();
+    for (unsigned index : queued) {
+        definitionQueued[index] = false;
+        refineBoundsFromRow(definitions[index]);
+    }
+}
+
+//
+// The definition x = a_1 y_1 + ... + a_n y_n of a row is kept as the sum c_0 x + c_1 y_1 + ... + c_n y_n = 0.  It
+// remains valid whatever the pivots do to the row in the tableau.  A variable v_k of the sum is bounded by the sum of
+// the others: c_k v_k >= -(sum of the largest values of c_i v_i, i != k) and c_k v_k <= -(sum of the smallest values
+// of c_i v_i, i != k).  The implied bounds that are tighter than the active bounds of v_k entail the bound atoms lying
+// between the two.
+//
+void Simplex::refineBoundsFromRow(std::vector<DefinitionTerm> const & terms) {
+    // The largest (smallest) value of c_i v_i comes from the upper (lower) bound of v_i for positive c_i
+    auto boundFor = [&](DefinitionTerm const & term, bool largest) -> std::pair<bool, LABoundRef> {
+        bool const upper = largest == (not isNegative(term.coeff));
+        if (upper ? not model->hasUBound(term.var) : not model->hasLBound(term.var)) {
+            return {false, LABoundRef_Undef};
+        }
+        return {true, upper ? model->readUBoundRef(term.var) : model->readLBoundRef(term.var)};
+    };
+    for (bool largest : {true, false}) {
+        Delta sum(0);
+        int unbounded = 0;
+        std::size_t unboundedIndex = 0;
+        for (std::size_t i = 0; i < terms.size() and unbounded < 2; ++i) {
+            auto bound = boundFor(terms[i], largest);
+            if (not bound.first) {
+                ++unbounded;
+                unboundedIndex = i;
+            } else {
+                sum += terms[i].coeff * boundStore[bound.second].getValue();
+            }
+        }
+        if (unbounded > 1) { continue; }
+        for (std::size_t k = 0; k < terms.size(); ++k) {
+            if (unbounded == 1 and k != unboundedIndex) { continue; }
+            DefinitionTerm const & target = terms[k];
+            auto const & targetBounds = boundStore.getBounds(target.var);
+            if (targetBounds.size() == 0) { continue; }
+            Delta othersSum = sum;
+            if (unbounded == 0) {
+                othersSum -= target.coeff * boundStore[boundFor(target, largest).second].getValue();
+            }
+            // From the largest values c_k v_k has a lower bound; v_k has a lower bound if c_k is positive
+            bool const impliesLower = largest != isNegative(target.coeff);
+            Delta const value = (Real(-1) * othersSum) / target.coeff;
+            BoundImplication implication;
+            if (impliesLower) {
+                if (model->hasLBound(target.var) and model->Lb(target.var) >= value) { continue; }
+                int idx = model->hasLBound(target.var) ? static_cast<int>(boundStore[model->readLBoundRef(target.var)].getIdx().x) + 1 : 0;
+                for (; idx < targetBounds.size() and boundStore[targetBounds[idx]].getValue() <= value; ++idx) {
+                    if (boundStore[targetBounds[idx]].getType() == bound_l) {
+                        implication.implied.push_back(targetBounds[idx]);
+                    }
+                }
+            } else {
+                if (model->hasUBound(target.var) and model->Ub(target.var) <= value) { continue; }
+                int idx = model->hasUBound(target.var) ? static_cast<int>(boundStore[model->readUBoundRef(target.var)].getIdx().x) - 1 : targetBounds.size() - 1;
+                for (; idx >= 0 and boundStore[targetBounds[idx]].getValue() >= value; --idx) {
+                    if (boundStore[targetBounds[idx]].getType() == bound_u) {
+                        implication.implied.push_back(targetBounds[idx]);
+                    }
+                }
+            }
+            if (implication.implied.empty()) { continue; }
+            Real const scale = isNegative(target.coeff) ? Real(-1) / target.coeff : Real(1) / target.coeff;
+            for (std::size_t i = 0; i < terms.size(); ++i) {
+                if (i == k) { continue; }
+                Real coeff = terms[i].coeff * scale;
+                if (isNegative(coeff)) { coeff.negate(); }
+                implication.explanation.push_back({boundFor(terms[i], largest).second, std::move(coeff)});
+            }
+            boundImplications.push_back(std::move(implication));
+        }
+    }
+}
+
+//
+// The exact pivots are costly when the coefficients grow, while the pivots of a Simplex in floating point are cheap.
+// The floating point Simplex runs on a copy of the current basic rows.  If it finds a basis where all the bounds hold
+// up to a tolerance, the exact tableau is moved to that basis and the non-basic variables to the bounds the floating
+// point solution rests on.  The exact Simplex then continues from there as usual, repairing what the rounding errors
+// broke, and alone decides the result.
+//
+void Simplex::guessBasisInFloatingPoint() {
+    auto toDouble = [](Delta const & value) { return value.R().get_d() + value.D().get_d() * floatDelta; };
+    FloatSimplex floatSimplex;
+    std::vector<LVRef> vars;
+    std::vector<bool> added;
+    auto addVar = [&](LVRef var) {
+        if (getVarId(var) >= added.size()) { added.resize(getVarId(var) + 1, false); }
+        if (added[getVarId(var)]) { return; }
+        added[getVarId(var)] = true;
+        vars.push_back(var);
+        floatSimplex.addVar(getVarId(var), toDouble(model->read(var)));
+        if (model->hasLBound(var)) { floatSimplex.setLowerBound(getVarId(var), toDouble(model->Lb(var))); }
+        if (model->hasUBound(var)) { floatSimplex.setUpperBound(getVarId(var), toDouble(model->Ub(var))); }
+    };
+    auto const & rows = tableau.getRows();
+    std::vector<FloatSimplex::Term> terms;
+    std::size_t numOfRows = 0;
+    for (unsigned i = 0; i < rows.size(); ++i) {
+        LVRef basicVar {i};
+        if (not tableau.isBasic(basicVar)) { continue; }
+        addVar(basicVar);
+        terms.clear();
+        for (auto const & term : rows[i]) {
+            addVar(term.var);
+            terms.push_back({getVarId(term.var), term.coeff.get_d()});
+        }
+        floatSimplex.addRow(getVarId(basicVar), terms);
+        ++numOfRows;
+    }
+    bool const feasible = floatSimplex.run(10 * numOfRows + 100);
+    simplex_stats.num_float_pivot_ops += floatSimplex.getNumOfPivots();
+    if (not feasible) { return; }
+
+    // Re-establish the basis exactly, pairing each leaving variable with an entering one from its current row
+    std::vector<bool> entering(added.size(), false);
+    for (LVRef var : vars) {
+        entering[getVarId(var)] = tableau.isNonBasic(var) and floatSimplex.isBasic(getVarId(var));
+    }
+    for (LVRef var : vars) {
+        if (not tableau.isBasic(var) or floatSimplex.isBasic(getVarId(var))) { continue; }
+        for (auto const & term : tableau.getRowPoly(var)) {
+            if (getVarId(term.var) < entering.size() and entering[getVarId(term.var)]) {
+                entering[getVarId(term.var)] = false;
+                changeBasis(var, term.var);
+                ++simplex_stats.num_float_basis_changes;
+                break;
+            }
+        }
+    }
+    // Move the non-basic variables to the bounds they have in the floating point solution
+    for (LVRef var : vars) {
+        if (not tableau.isNonBasic(var)) { continue; }
+        double const value = floatSimplex.getValue(getVarId(var));
+        Delta const * target = nullptr;
+        if (model->hasLBound(var) and floatSimplex.isCloseTo(value, toDouble(model->Lb(var)))) {
+            target = &model->Lb(var);
+        } else if (model->hasUBound(var) and floatSimplex.isCloseTo(value, toDouble(model->Ub(var)))) {
+            target = &model->Ub(var);
+        }
+        if (target and *target != model->read(var)) {
+            changeValueBy(var, *target - model->read(var));
+        }
+    }
+}
+
 void Simplex::changeValueBy(LVRef var, const Delta & diff) {
     // update var's value
     model->write(var, model->read(var) + diff);
@@ -338,16 +540,50 @@ Simplex::Explanation Simplex::getConflictingBounds(LVRef x, bool conflictOnLower
             expl.push_back({br, coeff});
         }
     }
+    if (conflictRelaxationLimit >= expl.size()) { relaxConflictingBounds(expl); }
     return expl;
 }
 
+/*
+ * Replaces the bounds of a conflict by the weakest active bounds of the same variables that still give a conflict.
+ * The active bounds of a variable are tightened over time, so a weaker bound was asserted earlier, possibly on a lower
+ * decision level, and the conflict clause allows a longer backjump.  The number of bounds stays the same: the bounds of
+ * a conflict from a single row are always an irreducible infeasible set, since the non-basic variables are independent.
+ */
+void Simplex::relaxConflictingBounds(Explanation & explanation) {
+    // With the upper bounds written as -v >= -u, the conflict is sum coeff * bound > 0
+    auto normalized = [this](LABoundRef br) {
+        LABound const & bound = boundStore[br];
+        return bound.getType() == bound_l ? bound.getValue() : Delta(0) - bound.getValue();
+    };
+    Delta slack(0);
+    for (auto const & term : explanation) {
+        slack += term.coeff * normalized(term.boundref);
+    }
+    assert(slack > 0);
+    for (auto & term : explanation) {
+        LABound const & bound = boundStore[term.boundref];
+        auto const & active = bound.getType() == bound_l ? model->getLBounds(bound.getLVRef()) : model->getUBounds(bound.getLVRef());
+        Delta const current = normalized(term.boundref);
+        for (LABoundRef candidate : active) {
+            if (candidate == term.boundref) { break; }
+            Delta loss = term.coeff * (current - normalized(candidate));
+            if (slack - loss > 0) {
+                slack -= loss;
+                term.boundref = candidate;
+                ++simplex_stats.num_relaxed_bounds;
+                break;
+            }
+        }
+    }
+    assert(slack > 0);
+}
+
 bool Simplex::checkValueConsistency() const {
     bool res = true;
     auto const & rows = tableau.getRows();
     for (unsigned i = 0; i < rows.size(); ++i) {
-        if (!rows[i]) { continue; }
         LVRef var {i};
-        assert(!tableau.isNonBasic(var));
         if (tableau.isBasic(var)) {
             res &= valueConsistent(var);
         }
@@ -360,7 +596,7 @@ bool Simplex::valueConsistent(LVRef v) const
 {
     const Delta& value = model->read(v);
     Delta sum(0);
-    for (auto & term : tableau.getRowPoly(v)){
+    for (auto const & term : tableau.getRowPoly(v)){
       sum += term.coeff * model->read(term.var);
     }
 
@@ -476,9 +712,8 @@ void Simplex::quasiToBasic(LVRef it) {
     // Literals are asserted in groups, so the current assignment might already be different then the last consistent one
     // Fix the last consistent value for this var, then fix the current value of the var
     Delta val; // initialized to 0
-    assert(model->changed_vars_vec.size() == 0);
+    assert(model->undo_log.empty());
     for (auto const & term : tableau.getRowPoly(it)) {
-        assert(model->read(term.var) == model->readBackupValue(term.var));
         val += term.coeff * model->read(term.var);
     }
     model->restoreVarWithValue(it, std::move(val));
@@ -496,6 +731,9 @@ void Simplex::processBufferOfActivatedBounds() {
         LVRef var = bufferOfActivatedBounds.back().first;
         LABoundRef boundRef = bufferOfActivatedBounds.back().second;
         bufferOfActivatedBounds.pop_back();
+        if (refinementRowSize > 0) {
+            touchedVars.push_back(var);
+        }
         assert(!tableau.isQuasiBasic(var));
         // Update the Tableau data if a non-basic variable
         if (tableau.isNonBasic(var)) {
@@ -510,7 +748,7 @@ void Simplex::processBufferOfActivatedBounds() {
                 newCandidate(var);
             } else {
                 // MB: Experience shows this should really not happen
-                assert(candidates.find(var) == candidates.end());
+                assert(not candidates.inHeap(getVarId(var)));
             }
         }
     }
@@ -10,12 +10,16 @@
 #include "lasolver/LAVar.h"
 #include "LRAModel.h"
 #include "SMTConfig.h"
+#include "Heap.h"
 
 class SimplexStats {
 public:
     int num_bland_ops;
     int num_pivot_ops;
-    SimplexStats() : num_bland_ops(0), num_pivot_ops(0) {}
+    int num_float_pivot_ops;
+    int num_float_basis_changes;
+    int num_relaxed_bounds;
+    SimplexStats() : num_bland_ops(0), num_pivot_ops(0), num_float_pivot_ops(0), num_float_basis_changes(0), num_relaxed_bounds(0) {}
     void printStatistics(std::ostream& os)
     {
         os << "; -------------------------" << '\n';
@@ -23,6 +27,9 @@ public:
         os << "; -------------------------" << '\n';
         os << "; Pivot operations.........: " << num_pivot_ops << '\n';
         os << "; Bland operations.........: " << num_bland_ops << '\n';
+        os << "; Float pivot operations...: " << num_float_pivot_ops << '\n';
+        os << "; Float basis changes......: " << num_float_basis_changes << '\n';
+        os << "; Relaxed conflict bounds..: " << num_relaxed_bounds << '\n';
     }
 };
 
@@ -33,8 +40,10 @@ class Simplex {
     Tableau tableau;
     SimplexStats simplex_stats;
     void  pivot(LVRef basic, LVRef nonBasic);
-    LVRef getBasicVarToFixByBland() const;
-    LVRef getBasicVarToFixByShortestPoly() const;
+    void  changeBasis(LVRef basic, LVRef nonBasic);  // The pivot on the tableau, without updating the values
+    void  guessBasisInFloatingPoint();
+    LVRef getBasicVarToFix() const;
+    void  setBlandRule(bool bland);
     LVRef findNonBasicForPivotByBland(LVRef basicVar);
     LVRef findNonBasicForPivotByHeuristic(LVRef basicVar);
     void  updateValues(LVRef basicVar, LVRef nonBasicVar);
@@ -42,10 +51,22 @@ class Simplex {
     inline void eraseCandidate(LVRef candidateVar);
 
     void changeValueBy( LVRef, const Delta & );             // Updates the bounds after constraint pushing
-    void refineBounds() { return; }                         // Compute the bounds for touched polynomials and deduces new bounds from it
-    // Out of bound candidates
-    // mutable std::unordered_set<LVRef, LVRefHash> candidates;
-    mutable std::set<LVRef, LVRefComp> candidates;
+    void refineBounds();                                    // Compute the bounds for touched polynomials and deduces new bounds from it
+    struct DefinitionTerm { LVRef var; opensmt::Real coeff; };
+    void storeDefinition(LVRef row, Tableau::Polynomial const & poly);
+    void refineBoundsFromRow(std::vector<DefinitionTerm> const & definition);
+    // Out of bound candidates, ordered by the pivoting rule: the shortest row first or, under Bland's rule, the
+    // smallest variable id first.  The row sizes are those at the time the candidate was last queued.
+    struct CandidateLt {
+        std::vector<std::size_t> const & rowSize;
+        bool const & bland;
+        bool operator() (int x, int y) const {
+            return (bland or rowSize[x] == rowSize[y]) ? x < y : rowSize[x] < rowSize[y];
+        }
+    };
+    bool blandRule = false;
+    std::vector<std::size_t> candidateRowSize;
+    Heap<CandidateLt> candidates;
 //    bool isEquality(LVRef) const;
     const Delta overBound(LVRef) const;
     // Model & bounds
@@ -62,20 +83,28 @@ public:
     };
     using Explanation = std::vector<ExplTerm>;
 
-    Simplex(std::unique_ptr<LRAModel> model, LABoundStore &bs) : model(std::move(model)), boundStore(bs) {}
-    Simplex(LABoundStore&bs) : model(new LRAModel(bs)), boundStore(bs) {}
+    // Bounds implied by the active bounds through a row of the tableau
+    struct BoundImplication {
+        std::vector<LABoundRef> implied;
+        Explanation explanation;    // The active bounds of the other variables of the row, with Farkas coefficients
+    };
+
+    Simplex(std::unique_ptr<LRAModel> model, LABoundStore &bs) : model(std::move(model)), boundStore(bs), candidates(CandidateLt{candidateRowSize, blandRule}) {}
+    Simplex(LABoundStore&bs) : Simplex(std::make_unique<LRAModel>(bs), bs) {}
     ~Simplex();
 
     void initModel() { model->init(); }
 
-    void clear() { model->clear(); candidates.clear(); tableau.clear(); boundsActivated.clear(); }
+    void clear() { model->clear(); candidates.clear(); tableau.clear(); boundsActivated.clear(); touchedVars.clear(); boundImplications.clear(); definitions.clear(); occurrences.clear(); definitionQueued.clear(); }
     Explanation checkSimplex();
     void pushBacktrackPoint() { model->pushBacktrackPoint(); }
     void popBacktrackPoint()  { model->popBacktrackPoint(); }
     inline void finalizeBacktracking() {
-        assert(model->changed_vars_vec.size() == 0);
+        assert(model->undo_log.empty());
         candidates.clear();
         bufferOfActivatedBounds.clear();
+        touchedVars.clear();
+        boundImplications.clear();
         assert(checkValueConsistency());
         assert(invariantHolds());
     }
@@ -95,7 +124,7 @@ public:
 
     void newNonbasicVar(LVRef v) { newVar(v); tableau.newNonbasicVar(v); }
     void nonbasicVar(LVRef v)    { newVar(v); tableau.nonbasicVar(v); }
-    void newRow(LVRef x, std::unique_ptr<Tableau::Polynomial> poly) { newVar(x); tableau.newRow(x, std::move(poly)); }
+    void newRow(LVRef x, std::unique_ptr<Tableau::Polynomial> poly) { newVar(x); storeDefinition(x, *poly); tableau.newRow(x, std::move(poly)); }
     Explanation getConflictingBounds(LVRef x, bool conflictOnLower);
     bool checkValueConsistency() const;
     bool invariantHolds() const;
@@ -109,9 +138,35 @@ public:
     const Delta& Ub(LVRef v) const { return model->Ub(v); }
     bool hasLBound(LVRef v) const {return model->hasLBound(v); }
     bool hasUBound(LVRef v) const {return model->hasUBound(v); }
+    bool isBasic(LVRef v) const { return tableau.isBasic(v); }
+    // The row of a basic variable: the variable equals the sum of the terms of the row
+    Tableau::Polynomial const & getRowPoly(LVRef basicVar) const { return tableau.getRowPoly(basicVar); }
+
+    // Guess a feasible basis in floating point before the exact check
+    void setFloatingPointGuide(bool enable) { floatingPointGuide = enable; }
+
+    // Conflicts with at most this many bounds have their bounds replaced by the weakest active ones (0 disables it)
+    void setConflictRelaxationLimit(std::size_t size) { conflictRelaxationLimit = size; }
+
+    // Bound refinement: rows whose polynomial has at most this many terms are used to derive bounds (0 disables it)
+    void setBoundRefinementRowSize(std::size_t size) { refinementRowSize = size; }
+    // The implications found by the last successful check
+    std::vector<BoundImplication> takeBoundImplications() { std::vector<BoundImplication> res; res.swap(boundImplications); return res; }
 
     // Keeping track of activated bounds
 private:
+    bool floatingPointGuide = false;
+    static constexpr double floatDelta = 1e-6;       // The value of the symbolic delta in floating point
+    static constexpr std::size_t refinementRowBudget = 1000; // The maximal number of definitions refined after a check
+    std::size_t refinementRowSize = 0;
+    std::size_t conflictRelaxationLimit = 0;
+    void relaxConflictingBounds(Explanation & explanation);
+    std::vector<LVRef> touchedVars;                  // Variables with a bound activated since the last refinement
+    std::vector<std::vector<DefinitionTerm>> definitions; // The definitions of the rows short enough for refinement
+    std::vector<std::vector<unsigned>> occurrences;  // The definitions each variable occurs in
+    std::vector<bool> definitionQueued;
+    std::vector<BoundImplication> boundImplications;
+
     std::vector<std::pair<LVRef, LABoundRef>> bufferOfActivatedBounds;
     std::vector<unsigned int> boundsActivated;
     unsigned int getNumOfBoundsActive(LVRef var) const {
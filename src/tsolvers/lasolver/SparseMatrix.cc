@@ -29,19 +29,14 @@ opensmt::Real SparseColMatrix::Col::product(const std::vector<FastRational> & va
 SparseColMatrix::TermVec SparseColMatrix::Col::toVector() const {
     std::vector<std::pair<IndexType, FastRational>> args;
     args.reserve(poly.size());
-    for (auto & term : poly) {
+    for (auto const & term : poly) {
         args.emplace_back(term.var, term.coeff);
     }
     return args;
 }
 
 const FastRational * SparseColMatrix::Col::tryGetCoeffFor(RowIndex rowIndex) const {
-    IndexType bound {rowIndex.count};
-    auto it = std::lower_bound(poly.begin(), poly.end(), bound, [](auto const & term, IndexType val) {
-        return term.var.x < val.x;
-    });
-    if (it == poly.end()) { return nullptr; }
-    return it->var == bound ? &it->coeff : nullptr;
+    return poly.tryGetCoeff(IndexType{rowIndex.count});
 }
 
 namespace {
@@ -27,8 +27,7 @@ void Tableau::nonbasicVar(LVRef v) {
 void Tableau::newNonbasicVar(LVRef v) {
     assert(!isProcessed(v));
     ensureTableauReadyFor(v);
-    assert(!cols[v.x]);
-    cols[v.x] = std::make_unique<Column>();
+    assert(cols[v.x].empty());
     varTypes[getVarId(v)] = VarType::NONBASIC;
 }
 
@@ -46,28 +45,28 @@ std::size_t Tableau::getNumOfCols() const {
 }
 
 std::size_t Tableau::getPolySize(LVRef basicVar) const {
-    assert(rows[basicVar.x]);
-    return rows[basicVar.x]->size();
+    assert(hasRow(basicVar));
+    return rows[basicVar.x].size();
 }
 
 const opensmt::Real & Tableau::getCoeff(LVRef basicVar, LVRef nonBasicVar) const {
-    assert(rows[basicVar.x]);
-    return rows[basicVar.x]->getCoeff(nonBasicVar);
+    assert(hasRow(basicVar));
+    return rows[basicVar.x].getCoeff(nonBasicVar);
 }
 
 const Tableau::column_t & Tableau::getColumn(LVRef nonBasicVar) const {
-    assert(cols[nonBasicVar.x]);
-    return *cols[nonBasicVar.x];
+    assert(isNonBasic(nonBasicVar));
+    return cols[nonBasicVar.x];
 }
 
 const Tableau::Polynomial & Tableau::getRowPoly(LVRef basicVar) const {
-    assert(rows[basicVar.x]);
-    return *rows[basicVar.x];
+    assert(hasRow(basicVar));
+    return rows[basicVar.x];
 }
 
 Tableau::Polynomial & Tableau::getRowPoly(LVRef basicVar) {
-    assert(rows[basicVar.x]);
-    return *rows[basicVar.x];
+    assert(hasRow(basicVar));
+    return rows[basicVar.x];
 }
 
 const Tableau::rows_t & Tableau::getRows() const {
@@ -86,28 +85,20 @@ std::vector<LVRef> Tableau::getNonBasicVars() const {
 }
 
 void Tableau::addRow(LVRef v, std::unique_ptr<Polynomial> p) {
-    assert(!rows[v.x]);
-    rows[v.x] = std::move(p);
-}
-
-std::unique_ptr<Tableau::Polynomial> Tableau::removeRow(LVRef v) {
-    assert(rows[v.x]);
-    std::unique_ptr<Polynomial> res;
-    assert(!res);
-    res.swap(rows[v.x]);
-    return res;
+    assert(rows[v.x].size() == 0);
+    rows[v.x] = std::move(*p);
 }
 
 void Tableau::moveRowFromTo(LVRef from, LVRef to) {
-    assert(!rows[to.x]);
-    assert(rows[from.x]);
+    assert(rows[to.x].size() == 0);
     rows[to.x] = std::move(rows[from.x]);
+    rows[from.x] = Polynomial();
 }
 
 void Tableau::moveColFromTo(LVRef from, LVRef to) {
-    assert(!cols[to.x]);
-    assert(cols[from.x]);
+    assert(cols[to.x].empty());
     cols[to.x] = std::move(cols[from.x]);
+    cols[from.x].clear();
 }
 
 bool Tableau::isProcessed(LVRef v) const {
@@ -117,13 +108,7 @@ bool Tableau::isProcessed(LVRef v) const {
 void Tableau::pivot(LVRef bv, LVRef nv) {
     assert(isBasic(bv));
     assert(isNonBasic(nv));
-    varTypes[getVarId(bv)] = VarType::NONBASIC;
-    varTypes[getVarId(nv)] = VarType::BASIC;
-    assert(cols[nv.x]);
-    assert(!cols[bv.x]);
     // compute the polynomial for nv
-    assert(rows[bv.x]);
-    assert(!rows[nv.x]);
     {
         Polynomial & nvPoly = getRowPoly(bv);
         const auto coeff = nvPoly.removeVar(nv);
@@ -134,6 +119,8 @@ void Tableau::pivot(LVRef bv, LVRef nv) {
         nvPoly.addTerm(bv, coeff.inverse());
     }
 
+    varTypes[getVarId(bv)] = VarType::NONBASIC;
+    varTypes[getVarId(nv)] = VarType::BASIC;
     // remove row for bv, add row for nv
     moveRowFromTo(bv, nv);
     // move the column from nv tto bv
@@ -141,9 +128,8 @@ void Tableau::pivot(LVRef bv, LVRef nv) {
 
     Polynomial & nvPoly = getRowPoly(nv);
     // update column information regarding this one poly
-    for(auto & term : nvPoly) {
+    for(auto const & term : nvPoly) {
         auto var = term.var;
-        assert(cols[var.x]);
         removeRowFromColumn(bv, var);
         addRowToColumn(nv, var);
     }
@@ -156,26 +142,22 @@ void Tableau::pivot(LVRef bv, LVRef nv) {
         // update the polynomials
         auto & poly = getRowPoly(rowVar);
         const auto nvCoeff = poly.removeVar(nv);
-        poly.merge(nvPoly, nvCoeff, tmp_storage,
+        poly.merge(nvPoly, nvCoeff,
                 // informAdded
                    [this, bv, rowVar](LVRef addedVar) {
                        if (addedVar == bv) { return; }
-                       assert(cols[addedVar.x]);
                        assert(!contains(getColumn(addedVar), rowVar));
                        addRowToColumn(rowVar, addedVar);
                    },
                 // informRemoved
                    [this, rowVar](LVRef removedVar) {
-                       assert(cols[removedVar.x]);
                        assert(contains(getColumn(removedVar), rowVar));
                        removeRowFromColumn(rowVar, removedVar);
                    }
         );
     }
-    assert(!cols[nv.x]);
-    assert(cols[bv.x]);
-    assert(!rows[bv.x]);
-    assert(rows[nv.x]);
+    assert(cols[nv.x].empty());
+    assert(rows[bv.x].size() == 0);
 }
 
 void Tableau::clear() {
@@ -194,7 +176,7 @@ bool Tableau::isQuasiBasic(LVRef v) const
 void Tableau::print() const {
     std::cout << "Rows:\n";
     for(unsigned i = 0; i != rows.size(); ++i) {
-        if (!rows[i]) { continue; }
+        if (!hasRow(LVRef{i})) { continue; }
         std::cout << "Var of the row: " << i << ';';
         for (const auto & term : this->getRowPoly(LVRef{i})) {
             std::cout << "( " << term.coeff << " | " << term.var.x << " ) ";
@@ -204,7 +186,7 @@ void Tableau::print() const {
     std::cout << '\n';
     std::cout << "Columns:\n";
     for(unsigned i = 0; i != cols.size(); ++i) {
-        if(!cols[i]) { continue; }
+        if(!isNonBasic(LVRef{i})) { continue; }
         std::cout << "Var of the column: " << i << "; Contains: ";
         for (auto var : getColumn(LVRef{i})) {
             std::cout << var.x << ' ';
@@ -219,15 +201,13 @@ bool Tableau::checkConsistency() const {
     for(unsigned i = 0; i < cols.size(); ++i) {
         LVRef var {i};
         if (isNonBasic(var)) {
-            res &= (cols[i] != nullptr);
-            assert(res);
-            for(auto row : *cols[i]) {
+            for(auto row : cols[i]) {
                 res &= this->getRowPoly(row).contains(var);
                 assert(res);
             }
         }
         else{
-            assert(!cols[i]);
+            assert(cols[i].empty());
         }
     }
 
@@ -236,12 +216,10 @@ bool Tableau::checkConsistency() const {
         if(isQuasiBasic(var)) {
             continue;
         }
-        if (!rows[i]) { assert(isNonBasic(var)); continue; }
-        res &= isBasic(var);
-        assert(res);
-        for (auto const & term : *rows[i]) {
+        if (!isBasic(var)) { assert(rows[i].size() == 0); continue; }
+        for (auto const & term : rows[i]) {
             auto termVar = term.var;
-            res &= isNonBasic(termVar) && cols[termVar.x];
+            res &= isNonBasic(termVar);
             assert(res);
             res &= contains(getColumn(termVar), var);
             assert(res);
@@ -266,7 +244,7 @@ void Tableau::normalizeRow(LVRef v) {
     }
     for (LVRef var : toEliminate) {
         auto const coeff = row.removeVar(var);
-        row.merge(getRowPoly(var), coeff, tmp_storage);
+        row.merge(getRowPoly(var), coeff);
     }
 }
 
@@ -288,7 +266,7 @@ void Tableau::basicToQuasi(LVRef v) {
     assert(isQuasiBasic(v));
 
     Polynomial & row = getRowPoly(v);
-    for (auto & term : row) {
+    for (auto const & term : row) {
         assert(isNonBasic(term.var));
         removeRowFromColumn(v, term.var);
     }
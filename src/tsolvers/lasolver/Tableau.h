@@ -63,7 +63,9 @@ protected:
 
     // using column_t = std::unordered_set<LVRef, LVRefHash>;
     using column_t = Column;
-    using rows_t = std::vector<std::unique_ptr<Polynomial>>;
+    // Rows and columns are stored inline, indexed by the variable; only the basic and quasi-basic variables have a
+    // non-empty row and only the non-basic variables have a column
+    using rows_t = std::vector<Polynomial>;
 //    using vars_t = std::unordered_set<LVRef, LVRefHash>;
     using vars_t = std::set<LVRef, LVRefComp>;
 
@@ -97,7 +99,7 @@ public:
     std::vector<LVRef> getNonBasicVars() const;
 
 private:
-    std::vector<std::unique_ptr<column_t>> cols;
+    std::vector<column_t> cols;
     rows_t rows;
 
     enum class VarType:char {
@@ -105,17 +107,15 @@ private:
     };
     std::vector<VarType> varTypes;
 
-    Tableau::Polynomial::poly_t tmp_storage;
-
     void ensureTableauReadyFor(LVRef v);
 
     void addRow(LVRef v, std::unique_ptr<Polynomial> p);
-    std::unique_ptr<Polynomial> removeRow(LVRef v);
     void moveRowFromTo(LVRef from, LVRef to);
     void moveColFromTo(LVRef from, LVRef to);
-    void addRowToColumn(LVRef row, LVRef col) { assert(cols[col.x]); cols[col.x]->addRow(row); }
-    void removeRowFromColumn(LVRef row, LVRef col) { assert(cols[col.x]); cols[col.x]->removeRow(row); }
-    void clearColumn(LVRef col) { assert(cols[col.x]); cols[col.x]->clear();}
+    void addRowToColumn(LVRef row, LVRef col) { assert(isNonBasic(col)); cols[col.x].addRow(row); }
+    void removeRowFromColumn(LVRef row, LVRef col) { assert(isNonBasic(col)); cols[col.x].removeRow(row); }
+    void clearColumn(LVRef col) { assert(isNonBasic(col)); cols[col.x].clear();}
+    bool hasRow(LVRef v) const { return isBasic(v) or isQuasiBasic(v); }
     void normalizeRow(LVRef row);
 };
 
@@ -0,0 +1,52 @@
+#ifndef OPENSMT_TESTINSTANCES_H
+#define OPENSMT_TESTINSTANCES_H
+
+#include <ArithLogic.h>
+
+#include <string>
+#include <vector>
+
+// Formulas shared by the tests of the SAT search
+
+// Pigeons into holes, one pigeon per hole; unsatisfiable when there are more pigeons than holes
+inline PTRef pigeonhole(Logic & logic, int pigeons, int holes) {
+    std::vector<std::vector<PTRef>> in(pigeons);
+    vec<PTRef> constraints;
+    for (int p = 0; p < pigeons; p++) {
+        vec<PTRef> somewhere;
+        for (int h = 0; h < holes; h++) {
+            in[p].push_back(logic.mkBoolVar(("p" + std::to_string(p) + "h" + std::to_string(h)).c_str()));
+            somewhere.push(in[p].back());
+        }
+        constraints.push(logic.mkOr(std::move(somewhere)));
+    }
+    for (int h = 0; h < holes; h++) {
+        for (int p = 0; p < pigeons; p++) {
+            for (int q = p + 1; q < pigeons; q++) {
+                constraints.push(logic.mkOr(logic.mkNot(in[p][h]), logic.mkNot(in[q][h])));
+            }
+        }
+    }
+    return logic.mkAnd(std::move(constraints));
+}
+
+// x_i <= 0 or x_i >= 2 with x_0 <= x_1 <= ... <= x_n-1; with x_0 >= 1 it is satisfiable only by x_i >= 2 for all i
+struct DisjunctionChain {
+    std::vector<PTRef> vars;
+    vec<PTRef> assertions;
+};
+
+inline DisjunctionChain disjunctionChain(ArithLogic & logic, int length) {
+    DisjunctionChain chain;
+    for (int i = 0; i < length; i++) {
+        PTRef x = logic.mkRealVar(("x" + std::to_string(i)).c_str());
+        chain.assertions.push(logic.mkOr(logic.mkLeq(x, logic.getTerm_RealZero()), logic.mkGeq(x, logic.mkRealConst(2))));
+        if (not chain.vars.empty()) {
+            chain.assertions.push(logic.mkGeq(logic.mkMinus(x, chain.vars.back()), logic.getTerm_RealZero()));
+        }
+        chain.vars.push_back(x);
+    }
+    return chain;
+}
+
+#endif //OPENSMT_TESTINSTANCES_H
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <Logic.h>
+#include <MainSolver.h>
+
+namespace {
+// Exposes the propagation and the clause removal of the SAT solver
+class BinarySolver : public CoreSMTSolver {
+public:
+    using CoreSMTSolver::CoreSMTSolver;
+    using CoreSMTSolver::propagate;
+    using CoreSMTSolver::removeClause;
+    using CoreSMTSolver::reason;
+    using CoreSMTSolver::locked;
+    using CoreSMTSolver::newVar;
+
+    CRef addLearntClause(vec<Lit> const & lits) {
+        CRef cr = ca.alloc(lits, {true, 2});
+        addLearnt(cr);
+        attachClause(cr);
+        return cr;
+    }
+    void decide(Lit l) {
+        newDecisionLevel();
+        uncheckedEnqueue(l);
+    }
+    Clause const & clause(CRef cr) const { return ca[cr]; }
+};
+}
+
+class BinaryClausesTest : public ::testing::Test {
+protected:
+    BinaryClausesTest() : logic{opensmt::Logic_t::QF_UF} {}
+    Logic logic;
+    SMTConfig config;
+};
+
+TEST_F(BinaryClausesTest, test_RemoveReasonImpliedInSecondPosition) {
+    auto theory = MainSolver::createTheory(logic, config);
+    TermMapper termMapper(logic);
+    THandler thandler(*theory, termMapper);
+    BinarySolver solver(config, thandler);
+    Lit a = mkLit(solver.newVar(true));
+    Lit b = mkLit(solver.newVar(true));
+    CRef cr = solver.addLearntClause({a, b});
+
+    // The binary watches propagate b without moving it to the front of the clause
+    solver.decide(~a);
+    ASSERT_EQ(solver.propagate(), CRef_Undef);
+    ASSERT_EQ(solver.value(b), l_True);
+    ASSERT_EQ(solver.reason(var(b)), cr);
+    ASSERT_EQ(solver.clause(cr)[1], b);
+    EXPECT_TRUE(solver.locked(solver.clause(cr)));
+
+    solver.removeClause(cr);
+    EXPECT_EQ(solver.reason(var(b)), CRef_Undef);
+    EXPECT_EQ(solver.reason(var(a)), CRef_Undef);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <ArithLogic.h>
+#include <MainSolver.h>
+
+#include "TestInstances.h"
+
+class ChronologicalBacktrackingTest : public ::testing::Test {
+protected:
+    ChronologicalBacktrackingTest() : logic(opensmt::Logic_t::QF_LRA) {
+        const char* msg;
+        config.setOption(SMTConfig::o_sat_chrono_backtrack, SMTOption(0), msg);
+    }
+    SMTConfig config;
+    ArithLogic logic;
+};
+
+TEST_F(ChronologicalBacktrackingTest, test_Pigeonhole) {
+    // Seven pigeons do not fit into six holes
+    MainSolver solver(logic, config, "chrono");
+    solver.insertFormula(pigeonhole(logic, 7, 6));
+    EXPECT_EQ(solver.check(), s_False);
+    auto const & sat = solver.getSMTSolver();
+    EXPECT_GT(sat.chrono_backtracks, 0u);
+    // Conflicts with a single literal on the conflict level imply that literal instead of learning a clause
+    EXPECT_GT(sat.conflict_implications, 0u);
+    EXPECT_LE(sat.conflict_implications, sat.conflicts);
+}
+
+TEST_F(ChronologicalBacktrackingTest, test_TheoryConflicts) {
+    auto chain = disjunctionChain(logic, 12);
+    MainSolver solver(logic, config, "chrono");
+    for (PTRef assertion : chain.assertions) {
+        solver.insertFormula(assertion);
+    }
+    solver.push();
+    solver.insertFormula(logic.mkGeq(chain.vars.front(), logic.getTerm_RealOne()));
+    ASSERT_EQ(solver.check(), s_True);
+    auto model = solver.getModel();
+    for (PTRef assertion : chain.assertions) {
+        EXPECT_EQ(model->evaluate(assertion), logic.getTerm_true());
+    }
+    EXPECT_EQ(model->evaluate(logic.mkGeq(chain.vars.back(), logic.mkRealConst(2))), logic.getTerm_true());
+    solver.pop();
+
+    solver.insertFormula(logic.mkGeq(chain.vars.front(), logic.getTerm_RealOne()));
+    solver.insertFormula(logic.mkLt(chain.vars.back(), logic.mkRealConst(2)));
+    EXPECT_EQ(solver.check(), s_False);
+}
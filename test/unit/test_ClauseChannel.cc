@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <ClauseChannel.h>
+
+#include <array>
+#include <thread>
+
+namespace {
+std::vector<std::vector<Lit>> receiveAll(ClauseChannel::Endpoint & endpoint) {
+    std::vector<std::vector<Lit>> received;
+    endpoint.receive([&received](vec<Lit> const & clause) {
+        received.emplace_back(clause.begin(), clause.end());
+    });
+    return received;
+}
+}
+
+TEST(ClauseChannelTest, test_PublishAndReceive) {
+    ClauseChannel channel(3);
+    ClauseChannel::Endpoint first(channel, 0);
+    ClauseChannel::Endpoint second(channel, 1);
+    ClauseChannel::Endpoint third(channel, 2);
+
+    vec<Lit> clause{mkLit(0), mkLit(1, true)};
+    EXPECT_TRUE(first.publish(clause));
+    EXPECT_TRUE(receiveAll(first).empty());  // Own clauses are not received
+    auto received = receiveAll(second);
+    ASSERT_EQ(received.size(), 1);
+    EXPECT_EQ(received[0], std::vector<Lit>({mkLit(0), mkLit(1, true)}));
+    EXPECT_TRUE(receiveAll(second).empty()); // Each clause is received once
+    EXPECT_EQ(receiveAll(third).size(), 1);
+
+    vec<Lit> tooLong;
+    for (unsigned i = 0; i <= ClauseChannel::maxClauseSize; i++) { tooLong.push(mkLit(i)); }
+    EXPECT_FALSE(first.publish(tooLong));
+    EXPECT_TRUE(receiveAll(second).empty());
+}
+
+TEST(ClauseChannelTest, test_Overwrite) {
+    ClauseChannel channel(2, 4);
+    ClauseChannel::Endpoint writer(channel, 0);
+    ClauseChannel::Endpoint reader(channel, 1);
+    for (int i = 0; i < 10; i++) {
+        writer.publish(vec<Lit>{mkLit(i)});
+    }
+    // Only the most recent clauses are still in the channel
+    auto received = receiveAll(reader);
+    ASSERT_EQ(received.size(), 4);
+    EXPECT_EQ(received.front(), std::vector<Lit>{mkLit(6)});
+    EXPECT_EQ(received.back(), std::vector<Lit>{mkLit(9)});
+}
+
+TEST(ClauseChannelTest, test_ConcurrentReaders) {
+    ClauseChannel channel(3, 16);
+    ClauseChannel::Endpoint writer(channel, 0);
+    int const published = 10000;
+    std::vector<std::thread> readers;
+    std::array<bool, 2> ok{true, true};
+    for (unsigned r = 1; r <= 2; r++) {
+        readers.emplace_back([&channel, &ok, r]() {
+            ClauseChannel::Endpoint reader(channel, r);
+            int last = -1;
+            while (last < published - 1) {
+                reader.receive([&](vec<Lit> const & clause) {
+                    // A clause is either received whole or not at all, and in publication order
+                    if (clause.size() != 2 or var(clause[0]) != var(clause[1]) or var(clause[0]) <= last) { ok[r-1] = false; }
+                    last = var(clause[0]);
+                });
+                if (not ok[r-1]) { return; }
+            }
+        });
+    }
+    for (int i = 0; i < published; i++) {
+        writer.publish(vec<Lit>{mkLit(i), mkLit(i, true)});
+    }
+    for (auto & reader : readers) { reader.join(); }
+    EXPECT_TRUE(ok[0]);
+    EXPECT_TRUE(ok[1]);
+}
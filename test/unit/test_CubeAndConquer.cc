@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <ArithLogic.h>
+#include <CubeAndConquer.h>
+#include <MainSplitter.h>
+
+#include "TestInstances.h"
+
+class CubeAndConquerTest : public ::testing::Test {
+protected:
+    CubeAndConquerTest() : logic(opensmt::Logic_t::QF_LRA) {}
+    SMTConfig config;
+    ArithLogic logic;
+};
+
+TEST_F(CubeAndConquerTest, test_SatisfiableCube) {
+    PTRef x = logic.mkRealVar("x");
+    PTRef y = logic.mkRealVar("y");
+    CubeAndConquer solver(logic, config, "cubes", 2);
+    solver.insertFormula(logic.mkGeq(logic.mkPlus(x, y), logic.mkRealConst(3)));
+    solver.insertFormula(logic.mkLeq(x, logic.getTerm_RealOne()));
+    PTRef cube = logic.mkLt(logic.getTerm_RealZero(), y);
+    ASSERT_EQ(solver.solve({logic.mkNot(cube), cube}), s_True);
+    EXPECT_EQ(solver.getSatisfiableCube(), 1);
+    auto model = solver.getModel();
+    EXPECT_EQ(model->evaluate(logic.mkGeq(logic.mkPlus(x, y), logic.mkRealConst(3))), logic.getTerm_true());
+    EXPECT_EQ(model->evaluate(cube), logic.getTerm_true());
+
+    // The cube of the previous call does not affect the next one
+    solver.insertFormula(logic.mkLeq(y, logic.getTerm_RealOne()));
+    ASSERT_EQ(solver.solve({logic.mkNot(cube), cube}), s_False);
+    EXPECT_EQ(solver.getCubeResults(), std::vector<sstat>({s_False, s_False}));
+    EXPECT_THROW(solver.getModel(), OsmtApiException);
+}
+
+TEST_F(CubeAndConquerTest, test_SplitterPartitions) {
+    // Every disjunction of the chain needs a decision, so the splitter reaches the levels it splits at
+    auto chain = disjunctionChain(logic, 6);
+    int const splitNum = 4;
+
+    SMTConfig splitConfig;
+    const char* msg;
+    splitConfig.setOption(SMTConfig::o_sat_scatter_split, SMTOption(1), msg);
+    splitConfig.setOption(SMTConfig::o_sat_split_num, SMTOption(splitNum), msg);
+    auto theory = MainSolver::createTheory(logic, splitConfig);
+    auto termMapper = std::make_unique<TermMapper>(logic);
+    auto thandler = std::make_unique<THandler>(*theory, *termMapper);
+    auto innerSolver = MainSplitter::createInnerSolver(splitConfig, *thandler);
+    MainSplitter splitter(std::move(theory), std::move(termMapper), std::move(thandler), std::move(innerSolver),
+                          logic, splitConfig, "splitter");
+    for (PTRef assertion : chain.assertions) {
+        splitter.insertFormula(assertion);
+    }
+    ASSERT_EQ(splitter.check(), s_Undef);
+    ASSERT_EQ(splitter.getSplits().size(), splitNum);
+
+    CubeAndConquer solver(logic, config, "cubes", 3);
+    for (PTRef assertion : chain.assertions) {
+        solver.insertFormula(assertion);
+    }
+    solver.insertFormula(logic.mkGeq(chain.vars.front(), logic.getTerm_RealOne()));
+    ASSERT_EQ(solver.solve(splitter), s_True);
+    EXPECT_EQ(solver.getCubeResults().size(), splitNum);
+    ASSERT_GE(solver.getSatisfiableCube(), 0);
+    EXPECT_EQ(solver.getCubeResults()[solver.getSatisfiableCube()], s_True);
+    auto model = solver.getModel();
+    for (PTRef assertion : chain.assertions) {
+        EXPECT_EQ(model->evaluate(assertion), logic.getTerm_true());
+    }
+    EXPECT_EQ(model->evaluate(logic.mkGeq(chain.vars.back(), logic.mkRealConst(2))), logic.getTerm_true());
+}
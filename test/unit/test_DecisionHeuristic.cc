@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <ArithLogic.h>
+#include <DecisionHeuristic.h>
+#include <MainSolver.h>
+
+#include "TestInstances.h"
+
+TEST(VMTFTest, test_BumpedVariablesComeFirst) {
+    vec<lbool> assigns;
+    VMTFHeuristic vmtf(assigns);
+    for (Var v = 0; v < 4; v++) {
+        assigns.push(l_Undef);
+        vmtf.newVar(v, 0);
+        vmtf.insert(v);
+    }
+    // The most recently added variable is the best candidate
+    for (Var v : {0, 2}) {
+        assigns[v] = l_False;
+        vmtf.bump(v);
+    }
+    vmtf.conflictDone();
+    ASSERT_FALSE(vmtf.empty());
+    EXPECT_EQ(vmtf.removeBest(), 3);
+    EXPECT_EQ(vmtf.removeBest(), 1);
+    EXPECT_TRUE(vmtf.empty());
+    // The bumped variables are candidates again when they are unassigned, in the order they were bumped
+    for (Var v : {0, 2}) {
+        assigns[v] = l_Undef;
+        vmtf.insert(v);
+    }
+    EXPECT_EQ(vmtf.removeBest(), 2);
+    EXPECT_EQ(vmtf.removeBest(), 0);
+}
+
+TEST(VMTFTest, test_BumpUnassigned) {
+    vec<lbool> assigns;
+    VMTFHeuristic vmtf(assigns);
+    for (Var v = 0; v < 3; v++) {
+        assigns.push(l_Undef);
+        vmtf.newVar(v, 0);
+        vmtf.insert(v);
+    }
+    vmtf.bump(0);
+    vmtf.conflictDone();
+    EXPECT_EQ(vmtf.removeBest(), 0);
+    EXPECT_EQ(vmtf.removeBest(), 2);
+    vmtf.popVar(2);
+    EXPECT_TRUE(vmtf.inQueue(1));
+    EXPECT_EQ(vmtf.removeBest(), 1);
+    EXPECT_TRUE(vmtf.empty());
+}
+
+TEST(CHBTest, test_RewardOnPropagation) {
+    CHBHeuristic chb;
+    for (Var v = 0; v < 3; v++) {
+        chb.newVar(v, 0);
+        chb.insert(v);
+    }
+    chb.conflictDone();
+    chb.conflictDone();
+    chb.bump(1);
+    chb.conflictDone();
+    // Only the propagated variables are rewarded, the variable of the latest conflict the most
+    chb.propagated(0);
+    chb.propagated(1);
+    chb.insert(2);
+    EXPECT_EQ(chb.removeBest(), 1);
+    EXPECT_EQ(chb.removeBest(), 0);
+    EXPECT_EQ(chb.removeBest(), 2);
+}
+
+class DecisionHeuristicTest : public ::testing::Test {
+protected:
+    DecisionHeuristicTest() : logic(opensmt::Logic_t::QF_LRA) {}
+    SMTConfig config;
+    ArithLogic logic;
+
+    void setHeuristic(const char* heuristic) {
+        const char* msg;
+        ASSERT_TRUE(config.setOption(SMTConfig::o_sat_decision_heuristic, SMTOption(heuristic), msg));
+    }
+
+    // The number of conflicts in showing that seven pigeons do not fit into six holes
+    uint64_t checkPigeonhole() {
+        MainSolver solver(logic, config, "heuristic");
+        solver.insertFormula(pigeonhole(logic, 7, 6));
+        EXPECT_EQ(solver.check(), s_False);
+        return solver.getSMTSolver().conflicts;
+    }
+
+    void checkIncremental() {
+        PTRef x = logic.mkRealVar("x");
+        PTRef y = logic.mkRealVar("y");
+        PTRef a = logic.mkBoolVar("a");
+        MainSolver solver(logic, config, "heuristic");
+        solver.insertFormula(logic.mkOr(a, logic.mkLeq(x, y)));
+        solver.push();
+        solver.insertFormula(logic.mkAnd(logic.mkNot(a), logic.mkLt(y, x)));
+        EXPECT_EQ(solver.check(), s_False);
+        solver.pop();
+        solver.insertFormula(logic.mkLt(y, x));
+        ASSERT_EQ(solver.check(), s_True);
+        EXPECT_EQ(solver.getModel()->evaluate(a), logic.getTerm_true());
+    }
+};
+
+TEST_F(DecisionHeuristicTest, test_VSIDS) {
+    setHeuristic(dheurs_vsids);
+    EXPECT_EQ(config.sat_decision_heuristic(), DecisionHeuristicType::vsids);
+    checkPigeonhole();
+    checkIncremental();
+}
+
+TEST_F(DecisionHeuristicTest, test_VMTF) {
+    setHeuristic(dheurs_vmtf);
+    EXPECT_EQ(config.sat_decision_heuristic(), DecisionHeuristicType::vmtf);
+    checkPigeonhole();
+    checkIncremental();
+}
+
+TEST_F(DecisionHeuristicTest, test_CHB) {
+    setHeuristic(dheurs_chb);
+    EXPECT_EQ(config.sat_decision_heuristic(), DecisionHeuristicType::chb);
+    checkPigeonhole();
+    checkIncremental();
+}
+
+TEST_F(DecisionHeuristicTest, test_HeuristicsSearchDifferently) {
+    uint64_t vsidsConflicts = checkPigeonhole();
+    setHeuristic(dheurs_vmtf);
+    EXPECT_NE(checkPigeonhole(), vsidsConflicts);
+    setHeuristic(dheurs_chb);
+    EXPECT_NE(checkPigeonhole(), vsidsConflicts);
+}
+
+TEST(DecisionHeuristicConfigTest, test_UnknownHeuristic) {
+    SMTConfig config;
+    const char* msg = nullptr;
+    EXPECT_FALSE(config.setOption(SMTConfig::o_sat_decision_heuristic, SMTOption("lrb"), msg));
+    EXPECT_EQ(config.sat_decision_heuristic(), DecisionHeuristicType::vsids);
+}
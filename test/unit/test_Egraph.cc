@@ -8,6 +8,8 @@
 #include "Egraph.h"
 #include "TreeOps.h"
 
+#include <algorithm>
+
 TEST(UseVector_test, testAdd){
     UseVector uv;
     ERef x{0};
@@ -139,3 +141,186 @@ TEST_F(EgraphTest, test_IncrementalAddition) {
     ASSERT_TRUE(egraph.assertLit({eq3, l_True}));
     ASSERT_EQ(egraph.check(true), TRes::SAT);
 }
+
+TEST_F(EgraphTest, test_ManyDistinctions) {
+    // More distinctions than fit in the bit vectors of the enodes
+    SRef sref = logic.declareUninterpretedSort("U");
+    int const n = 2 * maxDistinctClasses;
+    vec<PTRef> xs;
+    for (int i = 0; i < n + 2; ++i) {
+        xs.push(logic.mkVar(sref, ("x" + std::to_string(i)).c_str()));
+    }
+    PTRef z = logic.mkVar(sref, "z");
+    vec<PTRef> distincts;
+    for (int i = 0; i < n; ++i) {
+        distincts.push(logic.mkDistinct({xs[i], xs[i + 1], xs[i + 2]}));
+        ASSERT_TRUE(logic.isDisequality(distincts.last()));
+        egraph.declareAtom(distincts.last());
+    }
+    PTRef eq1 = logic.mkEq(xs[n - 1], z);
+    PTRef eq2 = logic.mkEq(z, xs[n + 1]);
+    egraph.declareAtom(eq1);
+    egraph.declareAtom(eq2);
+
+    egraph.pushBacktrackPoint();
+    for (PTRef distinct : distincts) {
+        ASSERT_TRUE(egraph.assertLit({distinct, l_True}));
+    }
+    ASSERT_EQ(egraph.check(true), TRes::SAT);
+
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq1, l_True}));
+    egraph.pushBacktrackPoint();
+    ASSERT_FALSE(egraph.assertLit({eq2, l_True}));
+    vec<PtAsgn> expl;
+    egraph.getConflict(expl);
+    ASSERT_EQ(expl.size(), 3);
+    for (auto pta : expl) {
+        bool pta_found = false;
+        for (auto pta_ref : vec<PtAsgn>{{distincts.last(), l_True}, {eq1, l_True}, {eq2, l_True}}) {
+            pta_found |= (pta_ref == pta);
+        }
+        ASSERT_TRUE(pta_found);
+    }
+    egraph.popBacktrackPoint();
+    egraph.popBacktrackPoint();
+
+    // After undoing the merge, z is no longer in the last distinction
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({eq2, l_True}));
+    ASSERT_EQ(egraph.check(true), TRes::SAT);
+}
+
+TEST_F(EgraphTest, test_EqualityPropagation) {
+    SRef sref = logic.declareUninterpretedSort("U");
+    PTRef x = logic.mkVar(sref, "x");
+    PTRef y = logic.mkVar(sref, "y");
+    PTRef z = logic.mkVar(sref, "z");
+    PTRef w = logic.mkVar(sref, "w");
+    PTRef u = logic.mkVar(sref, "u");
+    SymRef p = logic.declareFun("P", logic.getSort_bool(), {sref});
+    PTRef px = logic.mkUninterpFun(p, {x});
+    PTRef pz = logic.mkUninterpFun(p, {z});
+    PTRef xy = logic.mkEq(x, y);
+    PTRef yz = logic.mkEq(y, z);
+    PTRef xz = logic.mkEq(x, z);
+    PTRef zw = logic.mkEq(z, w);
+    PTRef xw = logic.mkEq(x, w);
+    PTRef wu = logic.mkEq(w, u);
+    PTRef dist = logic.mkDistinct({y, w, u});
+    for (PTRef atom : {px, pz, xy, yz, xz, zw, xw, wu, dist}) {
+        egraph.declareAtom(atom);
+    }
+    auto deductions = [this]() {
+        std::vector<PtAsgn> res;
+        for (auto ded = egraph.getDeduction(); ded.tr != PTRef_Undef; ded = egraph.getDeduction()) {
+            res.emplace_back(ded.tr, ded.sgn);
+        }
+        return res;
+    };
+    auto contains = [](vec<PtAsgn> const & reason, PtAsgn lit) {
+        return std::find(reason.begin(), reason.end(), lit) != reason.end();
+    };
+
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({xy, l_True}));
+    ASSERT_TRUE(egraph.assertLit({px, l_True}));
+    EXPECT_TRUE(deductions().empty());
+    ASSERT_TRUE(egraph.assertLit({yz, l_True}));
+    auto deduced = deductions();
+    ASSERT_EQ(deduced.size(), 2);
+    EXPECT_NE(std::find(deduced.begin(), deduced.end(), PtAsgn(xz, l_True)), deduced.end());
+    EXPECT_NE(std::find(deduced.begin(), deduced.end(), PtAsgn(pz, l_True)), deduced.end());
+
+    vec<PtAsgn> reason = egraph.getReasonFor({xz, l_True});
+    EXPECT_EQ(reason.size(), 3);
+    EXPECT_TRUE(contains(reason, PtAsgn(xz, l_False)));
+    EXPECT_TRUE(contains(reason, PtAsgn(xy, l_True)));
+    EXPECT_TRUE(contains(reason, PtAsgn(yz, l_True)));
+
+    reason = egraph.getReasonFor({pz, l_True});
+    EXPECT_EQ(reason.size(), 4);
+    EXPECT_TRUE(contains(reason, PtAsgn(pz, l_False)));
+    EXPECT_TRUE(contains(reason, PtAsgn(px, l_True)));
+
+    // The disequality of the classes decides the equalities between their other members
+    ASSERT_TRUE(egraph.assertLit({zw, l_False}));
+    deduced = deductions();
+    ASSERT_EQ(deduced.size(), 1);
+    EXPECT_EQ(deduced[0], PtAsgn(xw, l_False));
+    reason = egraph.getReasonFor({xw, l_False});
+    EXPECT_EQ(reason.size(), 4);
+    EXPECT_TRUE(contains(reason, PtAsgn(xw, l_True)));
+    EXPECT_TRUE(contains(reason, PtAsgn(zw, l_False)));
+    // The deduced literal is not processed again when asserted
+    ASSERT_TRUE(egraph.assertLit({xw, l_False}));
+
+    // So does a distinction
+    ASSERT_TRUE(egraph.assertLit({dist, l_True}));
+    deduced = deductions();
+    ASSERT_EQ(deduced.size(), 1);
+    EXPECT_EQ(deduced[0], PtAsgn(wu, l_False));
+    egraph.popBacktrackPoint();
+
+    // The deductions are undone on backtracking
+    egraph.pushBacktrackPoint();
+    ASSERT_TRUE(egraph.assertLit({xz, l_False}));
+    EXPECT_TRUE(deductions().empty());
+    ASSERT_TRUE(egraph.assertLit({xy, l_True}));
+    deduced = deductions();
+    ASSERT_EQ(deduced.size(), 1);
+    EXPECT_EQ(deduced[0], PtAsgn(yz, l_False));
+}
+
+TEST_F(EgraphTest, test_DisequalityPropagationOnMerge) {
+    SRef sref = logic.declareUninterpretedSort("U");
+    // The order of declaration makes b = c and c = a non-congruent when a and b are merged
+    PTRef b = logic.mkVar(sref, "b");
+    PTRef c = logic.mkVar(sref, "c");
+    PTRef a = logic.mkVar(sref, "a");
+    PTRef d = logic.mkVar(sref, "d");
+    PTRef ab = logic.mkEq(a, b);
+    PTRef bc = logic.mkEq(b, c);
+    PTRef ac = logic.mkEq(a, c);
+    PTRef ad = logic.mkEq(a, d);
+    for (PTRef atom : {ab, bc, ac, ad}) {
+        egraph.declareAtom(atom);
+    }
+    // a has more parents than b and stays the root, so its parent a = c must learn that the class of b is distinct from c
+    ASSERT_TRUE(egraph.assertLit({bc, l_False}));
+    EXPECT_EQ(egraph.getDeduction().tr, PTRef_Undef);
+    ASSERT_TRUE(egraph.assertLit({ab, l_True}));
+    auto ded = egraph.getDeduction();
+    EXPECT_EQ(PtAsgn(ded.tr, ded.sgn), PtAsgn(ac, l_False));
+    EXPECT_EQ(egraph.getDeduction().tr, PTRef_Undef);
+    vec<PtAsgn> reason = egraph.getReasonFor({ac, l_False});
+    EXPECT_EQ(reason.size(), 3);
+    EXPECT_NE(std::find(reason.begin(), reason.end(), PtAsgn(bc, l_False)), reason.end());
+
+    // The same through an n-ary distinction: the parents e = g and e = h of the root learn that f is distinct from them
+    PTRef e = logic.mkVar(sref, "e");
+    PTRef f = logic.mkVar(sref, "f");
+    PTRef g = logic.mkVar(sref, "g");
+    PTRef h = logic.mkVar(sref, "h");
+    PTRef ef = logic.mkEq(e, f);
+    PTRef eg = logic.mkEq(e, g);
+    PTRef eh = logic.mkEq(e, h);
+    PTRef ed = logic.mkEq(e, d);
+    PTRef dist = logic.mkDistinct({f, g, h});
+    for (PTRef atom : {ef, eg, eh, ed, dist}) {
+        egraph.declareAtom(atom);
+    }
+    ASSERT_TRUE(egraph.assertLit({dist, l_True}));
+    EXPECT_EQ(egraph.getDeduction().tr, PTRef_Undef);
+    ASSERT_TRUE(egraph.assertLit({ef, l_True}));
+    std::vector<PtAsgn> deduced;
+    for (ded = egraph.getDeduction(); ded.tr != PTRef_Undef; ded = egraph.getDeduction()) {
+        deduced.push_back(PtAsgn(ded.tr, ded.sgn));
+    }
+    EXPECT_EQ(deduced.size(), 2);
+    EXPECT_NE(std::find(deduced.begin(), deduced.end(), PtAsgn(eg, l_False)), deduced.end());
+    EXPECT_NE(std::find(deduced.begin(), deduced.end(), PtAsgn(eh, l_False)), deduced.end());
+    reason = egraph.getReasonFor({eh, l_False});
+    EXPECT_NE(std::find(reason.begin(), reason.end(), PtAsgn(dist, l_True)), reason.end());
+    EXPECT_NE(std::find(reason.begin(), reason.end(), PtAsgn(ef, l_True)), reason.end());
+}
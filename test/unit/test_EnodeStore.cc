@@ -99,4 +99,37 @@ TEST_F(EnodeStoreTest, testUFMixed) {
     ASSERT_TRUE(enodeStore.needsEnode(a));
     ASSERT_TRUE(enodeStore.needsEnode(mixed));
     ASSERT_TRUE(enodeStore.needsEnode(x));
-}
\ No newline at end of file
+}
+
+TEST_F(EnodeStoreTest, testSignatureTable) {
+    SRef ufsort = logic.declareUninterpretedSort("U");
+    SymRef f = logic.declareFun("f", ufsort, {ufsort, ufsort});
+    PTRef b = logic.mkVar(ufsort, "b");
+    EnodeStore enodeStore(logic);
+    enodeStore.constructTerm(b);
+    std::vector<ERef> apps;
+    for (int i = 0; i < 500; ++i) {
+        PTRef a = logic.mkVar(ufsort, ("a" + std::to_string(i)).c_str());
+        PTRef app = logic.mkUninterpFun(f, {a, b});
+        enodeStore.constructTerm(a);
+        enodeStore.constructTerm(app);
+        apps.push_back(enodeStore.getERef(app));
+    }
+    for (ERef app : apps) {
+        ASSERT_FALSE(enodeStore.containsSig(app));
+        enodeStore.insertSig(app);
+    }
+    // Removing every other application leaves the clusters of the table intact for the rest
+    for (std::size_t i = 0; i < apps.size(); i += 2) {
+        enodeStore.removeSig(apps[i]);
+    }
+    for (std::size_t i = 0; i < apps.size(); ++i) {
+        ASSERT_EQ(enodeStore.lookupSig(apps[i]), i % 2 == 0 ? ERef_Undef : apps[i]);
+    }
+    for (std::size_t i = 0; i < apps.size(); i += 2) {
+        enodeStore.insertSig(apps[i]);
+    }
+    for (ERef app : apps) {
+        ASSERT_EQ(enodeStore.lookupSig(app), app);
+    }
+}
@@ -47,7 +47,7 @@ TEST_F(UFExplainTest, test_UFExplain) {
     PTRef eq3 = logic.mkEq(f_f_c2_c0_c0.tr, c0.tr);
     PTRef eq7 = logic.mkEq(f_c1_c0.tr, c1.tr);
 
-    Explainer explainer(store);
+    Explainer explainer(store, logic);
     explainer.storeExplanation(c2.er, c1.er, {eq1, l_True});
     explainer.storeExplanation(f_f_c2_c0_c0.er, c0.er, {eq3, l_True});
     explainer.storeExplanation(c1.er, f_c1_c0.er, {eq7, l_True});
@@ -70,4 +70,23 @@ TEST_F(UFExplainTest, test_UFExplain) {
         }
     }
 
-}
\ No newline at end of file
+}
+
+TEST_F(UFExplainTest, test_CachedExplanationDroppedOnBacktrack) {
+    PTRef eq1 = logic.mkEq(c2.tr, c1.tr);
+    PTRef eq2 = logic.mkEq(c1.tr, c0.tr);
+
+    Explainer explainer(store, logic);
+    explainer.storeExplanation(c2.er, c1.er, {eq1, l_True});
+    explainer.storeExplanation(c1.er, c0.er, {eq2, l_True});
+    auto first = explainer.explain(c2.er, c0.er);
+    ASSERT_EQ(first.size(), 2);
+    auto second = explainer.explain(c0.er, c2.er);
+    ASSERT_EQ(second.size(), 2);
+    for (int i = 0; i < first.size(); ++i) {
+        EXPECT_EQ(first[i], second[i]);
+    }
+    // The explanation depends on the removed edge and must not be returned any more
+    explainer.removeExplanation();
+    ASSERT_THROW(explainer.explain(c2.er, c0.er), OsmtInternalException);
+}
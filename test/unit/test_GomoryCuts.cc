@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <ArithLogic.h>
+#include <MainSolver.h>
+#include <lasolver/GomoryCutCreator.h>
+#include <lasolver/LAVar.h>
+
+#include <random>
+
+using opensmt::Real;
+
+class GomoryCutCreatorTest : public ::testing::Test {
+protected:
+    LAVarStore vs;
+    LVRef x = vs.getNewVar();
+    LVRef y = vs.getNewVar();
+};
+
+TEST_F(GomoryCutCreatorTest, test_LowerBound) {
+    // b = 1/2 x with x >= 1 at its bound: b = 1/2 is fractional, and x >= 2 cuts the vertex off
+    auto cut = GomoryCutCreator::makeCut(Real(1, 2), {{x, Real(1, 2), 1, false, true}});
+    ASSERT_TRUE(cut.has_value());
+    ASSERT_EQ(cut->terms.size(), 1);
+    EXPECT_EQ(cut->terms[0].first, x);
+    EXPECT_EQ(cut->terms[0].second, 1);
+    EXPECT_EQ(cut->rhs, 2);
+}
+
+TEST_F(GomoryCutCreatorTest, test_UpperBound) {
+    // b = 1/2 x with x <= 3 at its bound: -x >= -2
+    auto cut = GomoryCutCreator::makeCut(Real(3, 2), {{x, Real(1, 2), 3, true, true}});
+    ASSERT_TRUE(cut.has_value());
+    ASSERT_EQ(cut->terms.size(), 1);
+    EXPECT_EQ(cut->terms[0].first, x);
+    EXPECT_EQ(cut->terms[0].second, -1);
+    EXPECT_EQ(cut->rhs, -2);
+}
+
+TEST_F(GomoryCutCreatorTest, test_IntegerValue) {
+    EXPECT_FALSE(GomoryCutCreator::makeCut(2, {{x, 2, 1, false, true}}).has_value());
+}
+
+TEST_F(GomoryCutCreatorTest, test_CutHoldsForIntegerPoints) {
+    // b = 1/3 x + 1/2 y with x >= 0 and y >= 1 at their bounds, b = 1/2
+    auto cut = GomoryCutCreator::makeCut(Real(1, 2), {{x, Real(1, 3), 0, false, true}, {y, Real(1, 2), 1, false, true}});
+    ASSERT_TRUE(cut.has_value());
+    for (int xv = 0; xv <= 12; ++xv) {
+        for (int yv = 1; yv <= 12; ++yv) {
+            Real b = Real(xv, 3) + Real(yv, 2);
+            Real lhs = 0;
+            for (auto const & term : cut->terms) {
+                lhs += term.second * (term.first == x ? xv : yv);
+            }
+            if (b.isInteger()) {
+                EXPECT_GE(lhs, cut->rhs);
+            }
+        }
+    }
+    // The current vertex x = 0, y = 1 violates the cut
+    Real lhsAtVertex = 0;
+    for (auto const & term : cut->terms) {
+        lhsAtVertex += term.second * (term.first == x ? 0 : 1);
+    }
+    EXPECT_LT(lhsAtVertex, cut->rhs);
+}
+
+TEST_F(GomoryCutCreatorTest, test_ContinuousVariable) {
+    // b = x - y with x integer at lower bound 0 and y continuous at upper bound 1/2: b = -1/2
+    auto cut = GomoryCutCreator::makeCut(Real(-1, 2), {{x, 1, 0, false, true}, {y, -1, Real(1, 2), true, false}});
+    ASSERT_TRUE(cut.has_value());
+    // The cut is not scaled, and the vertex violates it by one
+    Real lhs = 0;
+    for (auto const & term : cut->terms) {
+        lhs += term.second * (term.first == x ? Real(0) : Real(1, 2));
+    }
+    EXPECT_EQ(cut->rhs - lhs, 1);
+}
+
+class GomoryCutsTest : public ::testing::Test {
+protected:
+    GomoryCutsTest() : logic(opensmt::Logic_t::QF_LIA) {}
+    ArithLogic logic;
+
+    // Random bounded knapsack-like systems, solved with the given number of cuts per check
+    std::vector<sstat> solveRandomSystems(int cuts) {
+        SMTConfig config;
+        const char* msg;
+        EXPECT_TRUE(config.setOption(SMTConfig::o_lia_gomory_cuts, SMTOption(cuts), msg));
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> coeff(-9, 9);
+        std::vector<sstat> results;
+        for (int instance = 0; instance < 20; ++instance) {
+            int const n = 4;
+            vec<PTRef> vars;
+            vec<PTRef> constraints;
+            for (int i = 0; i < n; ++i) {
+                vars.push(logic.mkIntVar(("x" + std::to_string(i)).c_str()));
+                constraints.push(logic.mkGeq(vars.last(), logic.mkIntConst(0)));
+                constraints.push(logic.mkLeq(vars.last(), logic.mkIntConst(20)));
+            }
+            for (int row = 0; row < 3; ++row) {
+                vec<PTRef> terms;
+                for (int i = 0; i < n; ++i) {
+                    terms.push(logic.mkTimes(vars[i], logic.mkIntConst(coeff(rng))));
+                }
+                PTRef sum = logic.mkPlus(std::move(terms));
+                int const rhs = coeff(rng) * 5;
+                constraints.push(logic.mkGeq(sum, logic.mkIntConst(rhs)));
+                constraints.push(logic.mkLeq(sum, logic.mkIntConst(rhs + 1)));
+            }
+            MainSolver solver(logic, config, "gomory");
+            PTRef formula = logic.mkAnd(constraints);
+            solver.insertFormula(formula);
+            sstat res = solver.check();
+            if (res == s_True) {
+                EXPECT_EQ(solver.getModel()->evaluate(formula), logic.getTerm_true());
+            }
+            results.push_back(res);
+        }
+        return results;
+    }
+};
+
+TEST_F(GomoryCutsTest, test_SameResultsWithAndWithoutCuts) {
+    auto withoutCuts = solveRandomSystems(0);
+    auto withCuts = solveRandomSystems(2);
+    ASSERT_EQ(withoutCuts.size(), withCuts.size());
+    for (std::size_t i = 0; i < withCuts.size(); ++i) {
+        EXPECT_NE(withCuts[i], s_Undef);
+        EXPECT_EQ(withoutCuts[i], withCuts[i]) << "instance " << i;
+    }
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <lasolver/LASolver.h>
+
+#include <algorithm>
+
+class LABoundPropagationTest : public ::testing::Test {
+public:
+    LABoundPropagationTest() : logic(opensmt::Logic_t::QF_LRA) {
+        c.lra_poly_deduct_size = 5;
+    }
+    SMTConfig c;
+    ArithLogic logic;
+
+    static std::vector<PtAsgn> deductions(LASolver & solver) {
+        std::vector<PtAsgn> res;
+        for (auto ded = solver.getDeduction(); ded.tr != PTRef_Undef; ded = solver.getDeduction()) {
+            res.emplace_back(ded.tr, ded.sgn);
+        }
+        return res;
+    }
+
+    static bool contains(vec<PtAsgn> const & reason, PtAsgn lit) {
+        return std::find(reason.begin(), reason.end(), lit) != reason.end();
+    }
+};
+
+TEST_F(LABoundPropagationTest, test_SumOfBounds) {
+    LASolver solver(c, logic);
+    PTRef x = logic.mkRealVar("x");
+    PTRef y = logic.mkRealVar("y");
+    PTRef x_geq_1 = logic.mkGeq(x, logic.getTerm_RealOne());
+    PTRef y_geq_2 = logic.mkGeq(y, logic.mkRealConst(2));
+    PTRef sum_geq_3 = logic.mkGeq(logic.mkPlus(x, y), logic.mkRealConst(3));
+    PTRef sum_geq_4 = logic.mkGeq(logic.mkPlus(x, y), logic.mkRealConst(4));
+    for (PTRef atom : {x_geq_1, y_geq_2, sum_geq_3, sum_geq_4}) {
+        solver.declareAtom(atom);
+    }
+    solver.assertLit({x_geq_1, l_True});
+    solver.assertLit({y_geq_2, l_True});
+    ASSERT_EQ(solver.check(false), TRes::SAT);
+
+    auto deduced = deductions(solver);
+    ASSERT_EQ(deduced.size(), 1);
+    EXPECT_EQ(deduced[0], PtAsgn(sum_geq_3, l_True));
+
+    vec<PtAsgn> reason = solver.getReasonFor(deduced[0]);
+    EXPECT_EQ(reason.size(), 3);
+    EXPECT_TRUE(contains(reason, PtAsgn(sum_geq_3, l_False)));
+    EXPECT_TRUE(contains(reason, PtAsgn(x_geq_1, l_True)));
+    EXPECT_TRUE(contains(reason, PtAsgn(y_geq_2, l_True)));
+}
+
+TEST_F(LABoundPropagationTest, test_BoundOnRowVariable) {
+    LASolver solver(c, logic);
+    PTRef x = logic.mkRealVar("x");
+    PTRef y = logic.mkRealVar("y");
+    PTRef sum_leq_2 = logic.mkLeq(logic.mkPlus(x, y), logic.mkRealConst(2));
+    PTRef y_geq_1 = logic.mkGeq(y, logic.getTerm_RealOne());
+    PTRef x_leq_1 = logic.mkLeq(x, logic.getTerm_RealOne());
+    for (PTRef atom : {sum_leq_2, y_geq_1, x_leq_1}) {
+        solver.declareAtom(atom);
+    }
+    solver.assertLit({sum_leq_2, l_True});
+    solver.assertLit({y_geq_1, l_True});
+    ASSERT_EQ(solver.check(false), TRes::SAT);
+
+    auto deduced = deductions(solver);
+    ASSERT_EQ(deduced.size(), 1);
+    EXPECT_EQ(deduced[0], PtAsgn(x_leq_1, l_True));
+
+    vec<PtAsgn> reason = solver.getReasonFor(deduced[0]);
+    EXPECT_EQ(reason.size(), 3);
+    EXPECT_TRUE(contains(reason, PtAsgn(x_leq_1, l_False)));
+    EXPECT_TRUE(contains(reason, PtAsgn(sum_leq_2, l_True)));
+    EXPECT_TRUE(contains(reason, PtAsgn(y_geq_1, l_True)));
+}
+
+TEST_F(LABoundPropagationTest, test_Disabled) {
+    c.lra_poly_deduct_size = 0;
+    LASolver solver(c, logic);
+    PTRef x = logic.mkRealVar("x");
+    PTRef y = logic.mkRealVar("y");
+    PTRef x_geq_1 = logic.mkGeq(x, logic.getTerm_RealOne());
+    PTRef y_geq_2 = logic.mkGeq(y, logic.mkRealConst(2));
+    PTRef sum_geq_3 = logic.mkGeq(logic.mkPlus(x, y), logic.mkRealConst(3));
+    for (PTRef atom : {x_geq_1, y_geq_2, sum_geq_3}) {
+        solver.declareAtom(atom);
+    }
+    solver.assertLit({x_geq_1, l_True});
+    solver.assertLit({y_geq_2, l_True});
+    ASSERT_EQ(solver.check(false), TRes::SAT);
+    EXPECT_TRUE(deductions(solver).empty());
+}
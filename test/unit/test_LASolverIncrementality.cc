@@ -42,4 +42,45 @@ TEST_F(LASolverIncrementalityTest, test_Incrementality) {
     solver.assertLit({constr2, l_True});
     res = solver.check(true);
     ASSERT_EQ(res, TRes::UNSAT);
-}
\ No newline at end of file
+}
+TEST_F(LASolverIncrementalityTest, test_StateKeptAcrossClear) {
+    // 1 <= x + y and x <= 0
+    PTRef x = logic.mkRealVar("x");
+    PTRef y = logic.mkRealVar("y");
+    PTRef constr1 = logic.mkGeq(logic.mkPlus(x, y), logic.getTerm_RealOne());
+    PTRef constr2 = logic.mkLeq(x, logic.getTerm_RealZero());
+    solver.declareAtom(constr1);
+    solver.declareAtom(constr2);
+    solver.pushBacktrackPoint();
+    solver.assertLit({constr1, l_True});
+    solver.pushBacktrackPoint();
+    solver.assertLit({constr2, l_True});
+    ASSERT_EQ(solver.check(true), TRes::SAT);
+    solver.popBacktrackPoints(2);
+
+    // The next query declares the old atoms again together with the new atom y <= 0
+    solver.clearSolver();
+    PTRef constr3 = logic.mkLeq(y, logic.getTerm_RealZero());
+    solver.declareAtom(constr1);
+    solver.declareAtom(constr2);
+    solver.declareAtom(constr3);
+    solver.pushBacktrackPoint();
+    solver.assertLit({constr1, l_True});
+    solver.pushBacktrackPoint();
+    solver.assertLit({constr3, l_True});
+    ASSERT_EQ(solver.check(true), TRes::SAT);
+    solver.pushBacktrackPoint();
+    solver.assertLit({constr2, l_True});
+    ASSERT_EQ(solver.check(true), TRes::UNSAT);
+    solver.popBacktrackPoints(3);
+
+    // Without the bounds of the previous query, the negation of the first atom is consistent
+    solver.clearSolver();
+    solver.declareAtom(constr1);
+    solver.declareAtom(constr3);
+    solver.pushBacktrackPoint();
+    solver.assertLit({constr1, l_False});
+    solver.pushBacktrackPoint();
+    solver.assertLit({constr3, l_False});
+    ASSERT_EQ(solver.check(true), TRes::SAT);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <Logic.h>
+#include <MainSolver.h>
+
+#include <algorithm>
+
+namespace {
+// Exposes the learnt clause database of the SAT solver
+class TieredSolver : public CoreSMTSolver {
+public:
+    using CoreSMTSolver::CoreSMTSolver;
+    using CoreSMTSolver::reduceDB;
+
+    // A learnt clause of three fresh variables, identified by its first variable
+    Var learn(uint32_t glue, float activity, bool used) {
+        vec<Lit> lits;
+        for (int i = 0; i < 3; i++) {
+            lits.push(mkLit(newVar(true)));
+        }
+        CRef cr = ca.alloc(lits, {true, glue});
+        ca[cr].activity() = activity;
+        ca[cr].setUsed(used);
+        addLearnt(cr);
+        attachClause(cr);
+        return var(lits[0]);
+    }
+
+    // The glue of the learnt clause identified by v, or -1 if it has been removed
+    int glueOf(Var v) {
+        auto it = std::find_if(learnts.begin(), learnts.end(), [this, v](CRef cr) { return var(ca[cr][0]) == v; });
+        return it == learnts.end() ? -1 : static_cast<int>(ca[*it].getGlue());
+    }
+};
+}
+
+class LearntTiersTest : public ::testing::Test {
+protected:
+    LearntTiersTest() : logic{opensmt::Logic_t::QF_UF} {}
+    Logic logic;
+    SMTConfig config;
+};
+
+TEST_F(LearntTiersTest, test_ReduceDB) {
+    auto theory = MainSolver::createTheory(logic, config);
+    TermMapper termMapper(logic);
+    THandler thandler(*theory, termMapper);
+    TieredSolver solver(config, thandler);
+
+    uint32_t const localGlue = CoreSMTSolver::midTierGlue + 1;
+    Var core = solver.learn(CoreSMTSolver::coreTierGlue, 0, false);
+    Var midUsed = solver.learn(CoreSMTSolver::midTierGlue, 0, true);
+    Var midUnused = solver.learn(CoreSMTSolver::midTierGlue, 0, false);
+    std::vector<Var> local;
+    for (int i = 1; i <= 4; i++) {
+        local.push_back(solver.learn(localGlue, static_cast<float>(i), true));
+    }
+    EXPECT_EQ(solver.nLearnts(CoreSMTSolver::LearntTier::Core), 1);
+    EXPECT_EQ(solver.nLearnts(CoreSMTSolver::LearntTier::Mid), 2);
+    EXPECT_EQ(solver.nLearnts(CoreSMTSolver::LearntTier::Local), 4);
+
+    // The unused mid tier clause is demoted, and the less active half of the local tier is removed
+    solver.reduceDB();
+    EXPECT_EQ(solver.glueOf(core), CoreSMTSolver::coreTierGlue);
+    EXPECT_EQ(solver.glueOf(midUsed), CoreSMTSolver::midTierGlue);
+    EXPECT_EQ(solver.glueOf(midUnused), localGlue);
+    EXPECT_EQ(solver.glueOf(local[0]), -1);
+    EXPECT_EQ(solver.glueOf(local[1]), -1);
+    EXPECT_EQ(solver.glueOf(local[2]), localGlue);
+    EXPECT_EQ(solver.glueOf(local[3]), localGlue);
+    EXPECT_EQ(solver.nLearnts(CoreSMTSolver::LearntTier::Core), 1);
+    EXPECT_EQ(solver.nLearnts(CoreSMTSolver::LearntTier::Mid), 1);
+    EXPECT_EQ(solver.nLearnts(CoreSMTSolver::LearntTier::Local), 3);
+
+    // The mid tier clause was not used since the previous reduction; the demoted clause is now reduced by activity
+    solver.reduceDB();
+    EXPECT_EQ(solver.glueOf(core), CoreSMTSolver::coreTierGlue);
+    EXPECT_EQ(solver.glueOf(midUsed), localGlue);
+    EXPECT_EQ(solver.glueOf(midUnused), -1);
+    EXPECT_EQ(solver.glueOf(local[2]), localGlue);
+    EXPECT_EQ(solver.glueOf(local[3]), localGlue);
+    EXPECT_EQ(solver.nLearnts(CoreSMTSolver::LearntTier::Core), 1);
+    EXPECT_EQ(solver.nLearnts(CoreSMTSolver::LearntTier::Mid), 0);
+    EXPECT_EQ(solver.nLearnts(CoreSMTSolver::LearntTier::Local), 3);
+    EXPECT_EQ(solver.nLearnts(), 4);
+}
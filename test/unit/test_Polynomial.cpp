@@ -12,7 +12,6 @@ using Polynomial = PolynomialT<LVRef>;
 
 class PolyTest : public ::testing::Test {
 protected:
-    Polynomial::poly_t tmp_storage {};
     Polynomial poly1 {};
     Polynomial poly2 {};
 };
@@ -35,7 +34,7 @@ TEST_F(PolyTest, test_Merge){
     std::vector<LVRef> removed;
     auto add = [&added](LVRef v) { added.push_back(v); };
     auto remove = [&removed](LVRef v) { removed.push_back(v); };
-    poly1.merge(poly2, 1, tmp_storage, add, remove);
+    poly1.merge(poly2, 1, add, remove);
     ASSERT_EQ(added.size(),1);
     EXPECT_EQ(added[0], z);
     ASSERT_EQ(removed.size(),1);
@@ -60,7 +59,7 @@ TEST_F(PolyTest, test_Merge2){
     std::vector<LVRef> removed;
     auto add = [&added](LVRef v) { added.push_back(v); };
     auto remove = [&removed](LVRef v) { removed.push_back(v); };
-    poly1.merge(poly2, 1, tmp_storage, add, remove);
+    poly1.merge(poly2, 1, add, remove);
     ASSERT_EQ(added.size(),2);
     ASSERT_EQ(removed.size(),0);
     ASSERT_TRUE(poly1.contains(x1));
@@ -79,10 +78,56 @@ TEST_F(PolyTest, test_Merge3){
     std::vector<LVRef> removed;
     auto add = [&added](LVRef v) { added.push_back(v); };
     auto remove = [&removed](LVRef v) { removed.push_back(v); };
-    poly1.merge(poly2, 2, tmp_storage, add, remove);
+    poly1.merge(poly2, 2, add, remove);
     ASSERT_EQ(added.size(),0);
     ASSERT_EQ(removed.size(),1);
     EXPECT_EQ(removed[0], x2);
     ASSERT_TRUE(poly1.contains(x1));
     ASSERT_TRUE(!poly1.contains(x2));
-}
\ No newline at end of file
+}
+TEST_F(PolyTest, test_MergeCancelsSeveralTerms){
+    LVRef x1 {1};
+    LVRef x2 {2};
+    LVRef x3 {3};
+    LVRef x4 {4};
+    LVRef x5 {5};
+    poly1.addTerm(x1, 1);
+    poly1.addTerm(x2, 2);
+    poly1.addTerm(x4, -1);
+    poly1.addTerm(x5, 3);
+    poly2.addTerm(x2, 2);
+    poly2.addTerm(x3, 1);
+    poly2.addTerm(x5, 3);
+    std::vector<LVRef> added;
+    std::vector<LVRef> removed;
+    auto add = [&added](LVRef v) { added.push_back(v); };
+    auto remove = [&removed](LVRef v) { removed.push_back(v); };
+    poly1.merge(poly2, -1, add, remove);
+    ASSERT_EQ(added.size(), 1);
+    EXPECT_EQ(added[0], x3);
+    ASSERT_EQ(removed.size(), 2);
+    ASSERT_EQ(poly1.size(), 3);
+    std::vector<LVRef> vars;
+    for (auto const & term : poly1) {
+        vars.push_back(term.var);
+    }
+    EXPECT_EQ(vars, (std::vector<LVRef>{x1, x3, x4}));
+    EXPECT_EQ(poly1.getCoeff(x1), 1);
+    EXPECT_EQ(poly1.getCoeff(x3), -1);
+    EXPECT_EQ(poly1.getCoeff(x4), -1);
+}
+
+TEST_F(PolyTest, test_CopyAndRemove){
+    LVRef x {10};
+    LVRef y {20};
+    poly1.addTerm(y, FastRational(1, 3));
+    poly1.addTerm(x, 2);
+    Polynomial copy = poly1;
+    EXPECT_EQ(poly1.removeVar(x), 2);
+    EXPECT_FALSE(poly1.contains(x));
+    EXPECT_EQ(poly1.size(), 1);
+    ASSERT_EQ(copy.size(), 2);
+    EXPECT_EQ(copy.getCoeff(x), 2);
+    EXPECT_EQ(copy.getCoeff(y), FastRational(1, 3));
+    EXPECT_EQ(copy.begin()->var, x);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <ArithLogic.h>
+#include <PortfolioSolver.h>
+#include <ParallelWorker.h>
+#include <TermTranslator.h>
+
+#include "TestInstances.h"
+
+class TermTranslatorTest : public ::testing::Test {
+protected:
+    TermTranslatorTest() : source(opensmt::Logic_t::QF_UFLRA), target(opensmt::Logic_t::QF_UFLRA) {}
+    ArithLogic source;
+    ArithLogic target;
+};
+
+TEST_F(TermTranslatorTest, test_ArithmeticAndUF) {
+    SRef U = source.declareUninterpretedSort("U");
+    PTRef u = source.mkVar(U, "u");
+    SymRef f = source.declareFun("f", source.getSort_real(), {U});
+    PTRef x = source.mkRealVar("x");
+    PTRef fu = source.mkUninterpFun(f, {u});
+    PTRef fla = source.mkAnd(source.mkLeq(source.mkPlus(x, fu), source.mkRealConst(FastRational(1, 2))),
+                             source.mkNot(source.mkEq(x, source.getTerm_RealZero())));
+
+    TermTranslator translator(source, target);
+    PTRef translated = translator.translate(fla);
+    EXPECT_EQ(source.pp(fla), target.pp(translated));
+    EXPECT_EQ(translator.translate(fla), translated);
+
+    // Terms already present in the target are reused
+    PTRef targetX = target.mkRealVar("x");
+    EXPECT_EQ(translator.translate(x), targetX);
+    EXPECT_EQ(target.getSortRef(translator.translate(u)), target.declareUninterpretedSort("U"));
+}
+
+TEST(TermTranslatorErrorTest, test_DifferentLogics) {
+    ArithLogic lra(opensmt::Logic_t::QF_LRA);
+    ArithLogic lia(opensmt::Logic_t::QF_LIA);
+    EXPECT_THROW(TermTranslator(lra, lia), OsmtApiException);
+}
+
+class PortfolioTest : public ::testing::Test {
+protected:
+    PortfolioTest() : logic(opensmt::Logic_t::QF_LRA) {}
+    SMTConfig config;
+    ArithLogic logic;
+};
+
+TEST_F(PortfolioTest, test_WorkerConfigKeepsParameters) {
+    const char* msg;
+    config.setOption(SMTConfig::o_verbosity, SMTOption(1), msg);
+    config.sat_minimize_conflicts = 0;
+    config.sat_learn_up_to_size = 7;
+    config.lra_poly_deduct_size = 3;
+    config.sat_use_luby_restart = 0;
+    auto workerConfig = ParallelWorker::createConfig(config);
+    EXPECT_EQ(workerConfig->verbosity(), 1);
+    EXPECT_EQ(workerConfig->sat_minimize_conflicts, 0);
+    EXPECT_EQ(workerConfig->sat_learn_up_to_size, 7);
+    EXPECT_EQ(workerConfig->lra_poly_deduct_size, 3);
+    EXPECT_EQ(workerConfig->sat_use_luby_restart, 0);
+}
+
+TEST_F(PortfolioTest, test_RephasingInOddWorkers) {
+    PortfolioSolver solver(logic, config, "portfolio", 3);
+    EXPECT_EQ(solver.getWorker(0).getSMTSolver().rephase_interval, 0);
+    EXPECT_GT(solver.getWorker(1).getSMTSolver().rephase_interval, 0);
+    EXPECT_EQ(solver.getWorker(2).getSMTSolver().rephase_interval, 0);
+}
+
+TEST_F(PortfolioTest, test_SatWithModel) {
+    PortfolioSolver solver(logic, config, "portfolio", 4);
+    PTRef x = logic.mkRealVar("x");
+    PTRef y = logic.mkRealVar("y");
+    PTRef a = logic.mkBoolVar("a");
+    PTRef fla = logic.mkAnd({
+        logic.mkGeq(logic.mkPlus(x, y), logic.mkRealConst(3)),
+        logic.mkLeq(x, logic.getTerm_RealOne()),
+        logic.mkOr(a, logic.mkLeq(y, logic.getTerm_RealZero())),
+    });
+    solver.insertFormula(fla);
+    ASSERT_EQ(solver.check(), s_True);
+    ASSERT_GE(solver.getWinner(), 0);
+    auto model = solver.getModel();
+    EXPECT_EQ(model->evaluate(fla), logic.getTerm_true());
+    EXPECT_EQ(model->evaluate(a), logic.getTerm_true());
+}
+
+TEST_F(PortfolioTest, test_Incrementality) {
+    PortfolioSolver solver(logic, config, "portfolio", 3);
+    PTRef x = logic.mkRealVar("x");
+    PTRef y = logic.mkRealVar("y");
+    solver.insertFormula(logic.mkLeq(x, y));
+    solver.push();
+    solver.insertFormula(logic.mkLt(y, x));
+    EXPECT_EQ(solver.check(), s_False);
+    EXPECT_THROW(solver.getModel(), OsmtApiException);
+    EXPECT_TRUE(solver.pop());
+    solver.insertFormula(logic.mkLt(logic.getTerm_RealZero(), x));
+    ASSERT_EQ(solver.check(), s_True);
+    auto model = solver.getModel();
+    EXPECT_EQ(model->evaluate(logic.mkLeq(x, y)), logic.getTerm_true());
+}
+
+TEST_F(PortfolioTest, test_PigeonholeWithClauseSharing) {
+    PortfolioSolver solver(logic, config, "portfolio", 3);
+    solver.insertFormula(pigeonhole(logic, 7, 6));
+    EXPECT_EQ(solver.check(), s_False);
+    EXPECT_GE(solver.getWinner(), 0);
+    uint64_t exported = 0;
+    for (unsigned int i = 0; i < solver.getNumberOfWorkers(); i++) {
+        exported += solver.getWorker(i).getSMTSolver().exported_clauses;
+    }
+    EXPECT_GT(exported, 0u);
+}
+
+TEST(PortfolioUFTest, test_UninterpretedFunctions) {
+    SMTConfig config;
+    Logic logic(opensmt::Logic_t::QF_UF);
+    SRef U = logic.declareUninterpretedSort("U");
+    PTRef a = logic.mkVar(U, "a");
+    PTRef b = logic.mkVar(U, "b");
+    SymRef f = logic.declareFun("f", U, {U});
+    PTRef fa = logic.mkUninterpFun(f, {a});
+    PTRef fb = logic.mkUninterpFun(f, {b});
+    PortfolioSolver solver(logic, config, "portfolio", 2);
+    solver.insertFormula(logic.mkAnd(logic.mkEq(fa, b), logic.mkNot(logic.mkEq(fb, a))));
+    ASSERT_EQ(solver.check(), s_True);
+    auto model = solver.getModel();
+    EXPECT_EQ(model->evaluate(fa), model->evaluate(b));
+    EXPECT_EQ(model->evaluate(logic.mkEq(fb, a)), logic.getTerm_false());
+
+    solver.insertFormula(logic.mkEq(a, b));
+    EXPECT_EQ(solver.check(), s_False);
+}
@@ -4,12 +4,14 @@
 #include <Vec.h>
 #include <Sort.h>
 
+#include <thread>
+
 using Real = opensmt::Real;
 
-TEST(Rationals_test, test_division_int32min)
+TEST(Rationals_test, test_division_wordmin)
 {
-    // INT32_MIN
-    Real r {"-2147483648"};
+    // INT64_MIN
+    Real r {"-9223372036854775808"};
     ASSERT_LT(r,0);
     Real nom = r/2047;
     Real den = r/3071;
@@ -20,10 +22,10 @@ TEST(Rationals_test, test_division_int32min)
     ASSERT_GT(nom, 0);
 }
 
-TEST(Rationals_test, test_abs_val_int32min)
+TEST(Rationals_test, test_abs_val_wordmin)
 {
-    int32_t x = -2147483648;
-    ASSERT_EQ(absVal(x), 2147483648);
+    word x = INT64_MIN;
+    ASSERT_EQ(absVal(x), 9223372036854775808u);
 }
 
 TEST(Rationals_test, test_normalized)
@@ -107,16 +109,16 @@ TEST(Rationals_test, test_doubleRepresentation) {
     EXPECT_TRUE(res < 0);
 }
 
-TEST(Rationals_test, test_negate_int32min) {
-    // INT32_MIN
-    Real r {"-2147483648"};
+TEST(Rationals_test, test_negate_wordmin) {
+    // INT64_MIN
+    Real r {"-9223372036854775808"};
     r.negate();
     EXPECT_TRUE(r > 0);
 }
 
-TEST(Rationals_test, test_negate_minus_int32min) {
-    // - INT32_MIN = 2^31
-    Real r {"2147483648"};
+TEST(Rationals_test, test_negate_minus_wordmin) {
+    // - INT64_MIN = 2^63
+    Real r {"9223372036854775808"};
     Real neg = -r;
     EXPECT_TRUE(neg.isWellFormed());
     EXPECT_TRUE(neg < 0);
@@ -125,19 +127,33 @@ TEST(Rationals_test, test_negate_minus_int32min) {
 }
 
 TEST(Rationals_test, test_additionAssign) {
-    Real a {"2147483640"};
+    Real a {"9223372036854775800"};
     Real b {"10"};
     additionAssign(a,b);
-    EXPECT_EQ(a, Real{"2147483650"} );
+    EXPECT_EQ(a, Real{"9223372036854775810"} );
+}
+
+TEST(Rationals_test, test_additionAssign_wide_denominators)
+{
+    // The sum of the numerators overflows a word, and its common factor with the product of the denominators does not
+    // fit a word
+    FastRational a(INT64_MAX, uword(1) << 40);
+    FastRational b(INT64_MAX - (word(1) << 25) + 2, uword(1) << 40);
+    FastRational const expected("549755813887/32768");
+    EXPECT_EQ(a + b, expected);
+    additionAssign(a, b);
+    EXPECT_EQ(a, expected);
+    EXPECT_TRUE(a.wordPartValid());
+    EXPECT_TRUE(a.isWellFormed());
 }
 
 TEST(Rationals_test, test_overwrite)
 {
-    Real r(INT32_MAX);
+    Real r(INT64_MAX);
     Real q(0);
     r *= 10;
     r = 0;
-    r = INT32_MAX;
+    r = INT64_MAX;
     r *= 10;
     r = q;
 }
@@ -146,7 +162,11 @@ TEST(Rationals_test, test_uword)
 {
     uint32_t x = 2589903246;
     FastRational f(x);
-    ASSERT_TRUE(f.mpqPartValid());
+    ASSERT_TRUE(f.wordPartValid());
+    uint64_t y = 10589903246589903246u;
+    FastRational g(y);
+    ASSERT_TRUE(g.mpqPartValid());
+    EXPECT_EQ(g, FastRational("10589903246589903246"));
 }
 
 TEST(Rationals_test, test_modulo)
@@ -160,19 +180,26 @@ TEST(Rationals_test, test_modulo)
 TEST(Rationals_test, test_creation)
 {
     {
-        // a = INT_MIN / INT_MAX is the number that has the smallest nominator and biggest denominator such that it still fits the word representation
-        FastRational a(INT_MIN, INT_MAX);
+        // a = INT64_MIN / INT64_MAX is the number that has the smallest nominator and biggest denominator such that it still fits the word representation
+        FastRational a(INT64_MIN, INT64_MAX);
         ASSERT_TRUE(a.wordPartValid());
         ASSERT_FALSE(a.mpqMemoryAllocated());
-        ASSERT_EQ(a, FastRational("-2147483648/2147483647"));
+        ASSERT_EQ(a, FastRational("-9223372036854775808/9223372036854775807"));
     }
     {
-        // a = INT_MAX / INT_MAX = 1 but in current implementation handles big values.
-        FastRational a(INT_MAX,INT_MAX);
+        // a = INT64_MAX / INT64_MAX = 1 but in current implementation handles big values.
+        FastRational a(INT64_MAX,INT64_MAX);
         ASSERT_TRUE(a.wordPartValid());
         ASSERT_FALSE(a.mpqMemoryAllocated());
         ASSERT_EQ(a, 1);
     }
+    {
+        // The common factor of a negative numerator and the denominator is divided out
+        FastRational a(-6, 4);
+        ASSERT_TRUE(a.wordPartValid());
+        ASSERT_EQ(a, FastRational("-3/2"));
+        ASSERT_EQ(FastRational(INT64_MIN, 2), FastRational("-4611686018427387904"));
+    }
 }
 
 TEST(Rationals_test, test_addition)
@@ -211,10 +238,10 @@ TEST(Rationals_test, test_addition)
         // b.den == 1
         // a.num + b.num*a.den does not fit in word (but fits by definition in lword)
         // (a.num + b.num*a.den) / gcd(a.num+b.num*a.den, a.den) does not fit in word
-        FastRational a(INT_MAX,UINT_MAX);
-        FastRational b(INT_MAX);
+        FastRational a(INT64_MAX,UINT64_MAX);
+        FastRational b(INT64_MAX);
         FastRational sum = a+b;
-        ASSERT_EQ(sum, FastRational("9223372032559808512/4294967295"));
+        ASSERT_EQ(sum, FastRational("170141183460469231713240559642174554112/18446744073709551615"));
         ASSERT_FALSE(sum.wordPartValid());
     }
     {
@@ -222,19 +249,19 @@ TEST(Rationals_test, test_addition)
         // a and b negative
         // a.num + b.num*a.den does not fit in word (but fits by definition in lword)
         // (a.num + b.num*a.den) / gcd(a.num+b.num*a.den, a.den) does not fit in word
-        FastRational a(INT_MIN,UINT_MAX);
-        FastRational b(INT_MIN);
+        FastRational a(INT64_MIN,UINT64_MAX);
+        FastRational b(INT64_MIN);
         FastRational sum = a+b;
-        ASSERT_EQ(sum, FastRational("-9223372036854775808/4294967295"));
+        ASSERT_EQ(sum, FastRational("-170141183460469231731687303715884105728/18446744073709551615"));
         ASSERT_FALSE(sum.wordPartValid());
     }
     {
         // b.den == 1
         // a.num + b.num*a.den does not fit in a word (but fits by definition in lword)
-        FastRational a(INT_MAX,8);
+        FastRational a(INT64_MAX,8);
         FastRational b(2);
         FastRational sum = a+b;
-        ASSERT_EQ(sum, FastRational("2147483663/8"));
+        ASSERT_EQ(sum, FastRational("9223372036854775823/8"));
         ASSERT_FALSE(sum.wordPartValid());
     }
 }
@@ -265,46 +292,47 @@ TEST(Rationals_test, test_subtraction)
     }
     {
         FastRational a(0);
-        FastRational s = a - FastRational(INT_MIN);
+        FastRational s = a - FastRational(INT64_MIN);
         ASSERT_FALSE(s.wordPartValid());
         ASSERT_TRUE(s.mpqPartValid());
-        ASSERT_EQ(s, FastRational(INT_MAX)+1);
+        ASSERT_EQ(s, FastRational(INT64_MAX)+1);
     }
     {
-        FastRational a(INT_MAX,UINT_MAX);
-        FastRational b(INT_MIN);
+        FastRational a(INT64_MAX,UINT64_MAX);
+        FastRational b(INT64_MIN);
         ASSERT_TRUE(a.wordPartValid());
         ASSERT_FALSE(a.mpqMemoryAllocated());
         ASSERT_TRUE(b.wordPartValid());
         ASSERT_FALSE(b.mpqMemoryAllocated());
         FastRational c = a - b;
-        FastRational res("9223372036854775807/4294967295");
+        FastRational res("170141183460469231731687303715884105727/18446744073709551615");
         ASSERT_TRUE(res.mpqPartValid());
         ASSERT_EQ(c, res);
     }
     {
-        FastRational a(INT_MIN, UINT_MAX);
-        FastRational b(INT_MAX);
+        FastRational a(INT64_MIN, UINT64_MAX);
+        FastRational b(INT64_MAX);
         FastRational c = a - b;
 
     }
     {
-        FastRational a("-2147483645/4294967294");
-        FastRational b("2147483647/4294967295");
+        FastRational a("-9223372036854775805/18446744073709551614");
+        FastRational b("9223372036854775807/18446744073709551615");
         ASSERT_TRUE(a.wordPartValid());
         ASSERT_TRUE(b.wordPartValid());
         FastRational c = a - b;
         ASSERT_TRUE(c.mpqPartValid());
-        FastRational res("-18446744050087231493/18446744060824649730");
+        FastRational res("-340282366920938463361917515026365677573/340282366920938463408034375210639556610");
         ASSERT_EQ(c, res);
     }
     {
-        FastRational a("-2147483647/4294967292");
-        FastRational b("2147483645/4294967294");
+        FastRational a("-9223372036854775807/18446744073709551612");
+        FastRational b("9223372036854775805/18446744073709551614");
         ASSERT_TRUE(a.wordPartValid());
         ASSERT_TRUE(b.wordPartValid());
         FastRational c = a - b;
         ASSERT_TRUE(c.mpqPartValid());
+        ASSERT_EQ(c, FastRational("-170141183460469231667123699457900675079/170141183460469231676347071494755450884"));
     }
 }
 
@@ -346,8 +374,15 @@ TEST(Rationals_test, test_operatorAssign)
         // (/ 1333332 329664997) += (- 332667998001/329664997000)
         FastRational f(1333332, 329664997);
         f += -FastRational("332667998001/329664997000");
-        // 331334666001/329664997000
+        // 331334666001/329664997000 fits the word representation
         ASSERT_EQ(f, -FastRational("331334666001/329664997000"));
+        ASSERT_TRUE(f.wordPartValid());
+    }
+    {
+        // The denominator of the sum needs more than 64 bits
+        FastRational f("1333332/1099511627791");
+        f += -FastRational("332667998001/35184372088841");
+        ASSERT_EQ(f, -FastRational("365725419546846685497579/38685626228205794776580231"));
         ASSERT_TRUE(f.mpqMemoryAllocated());
         ASSERT_FALSE(f.wordPartValid());
     }
@@ -450,10 +485,15 @@ TEST(Rationals_test, test_ceil)
 
 TEST(Rationals_test, test_mod)
 {
-    FastRational a(INT_MAX);
-    FastRational b(INT_MIN);
+    FastRational a(INT64_MAX);
+    FastRational b(INT64_MIN);
     FastRational res = a % b;
-    ASSERT_EQ(res, (INT_MIN+1));
+    // INT64_MAX - floor(INT64_MAX / INT64_MIN) * INT64_MIN
+    ASSERT_EQ(res, -1);
+    ASSERT_EQ(FastRational(7) % FastRational(-3), -2);
+    ASSERT_EQ(FastRational(-7) % FastRational(3), 2);
+    ASSERT_EQ(FastRational(-7) % FastRational(-3), -1);
+    ASSERT_EQ(FastRational(INT64_MIN) % FastRational(-1), 0);
 }
 
 TEST(Rationals_test, test_addNegated)
@@ -465,15 +505,15 @@ TEST(Rationals_test, test_addNegated)
         ASSERT_EQ(res, 0);
     }
     {
-        FastRational a(INT_MAX);
-        FastRational b(INT_MIN);
+        FastRational a(INT64_MAX);
+        FastRational b(INT64_MIN);
         FastRational res = a + b;
         ASSERT_EQ(res, -1);
     }
 }
 
 TEST(Rationals_test, testWordRepresentation_Negate) {
-    FastRational a(INT_MIN); // a fits into word representation
+    FastRational a(INT64_MIN); // a fits into word representation
     ASSERT_TRUE(a.wordPartValid());
     a.negate(); // a now does not fit into word representation
     ASSERT_FALSE(a.wordPartValid());
@@ -482,7 +522,7 @@ TEST(Rationals_test, testWordRepresentation_Negate) {
 }
 
 TEST(Rationals_test, testWordRepresentation_Inverse) {
-    uword val = INT_MAX;
+    uword val = INT64_MAX;
     ++val;
     FastRational a(1, val); // a fits into word representation
     ASSERT_TRUE(a.wordPartValid());
@@ -492,3 +532,40 @@ TEST(Rationals_test, testWordRepresentation_Inverse) {
     ASSERT_TRUE(a.wordPartValid());
 }
 
+
+TEST(Rationals_test, testMpqPool_Reuse) {
+    // Each thread has its own pool, so the statistics of a fresh thread are not affected by the other tests
+    std::thread([]() {
+        MpqPoolStatistics const & stats = FastRational::getMpqPoolStatistics();
+        {
+            FastRational a(INT64_MIN);
+            a.negate();
+            ASSERT_FALSE(a.wordPartValid());
+        }
+        EXPECT_EQ(stats.spills, 1);
+        EXPECT_EQ(stats.allocations, 1);
+        {
+            FastRational a(INT64_MIN);
+            a.negate();
+        }
+        EXPECT_EQ(stats.spills, 2);
+        EXPECT_EQ(stats.allocations, 1);
+        EXPECT_EQ(stats.frees, 0);
+        FastRational::trimMpqPool();
+        EXPECT_EQ(stats.frees, 1);
+    }).join();
+}
+
+TEST(Rationals_test, testMpqPool_CrossThreadRelease) {
+    FastRational a(INT64_MIN);
+    std::thread([&a]() {
+        FastRational b(INT64_MIN);
+        b.negate();
+        a = b * b;
+    }).join();
+    ASSERT_FALSE(a.wordPartValid());
+    // The value computed in the other thread is released to the pool of this thread
+    a = 1;
+    ASSERT_TRUE(a.wordPartValid());
+    EXPECT_EQ(FastRational(INT64_MIN) * FastRational(INT64_MIN), FastRational("85070591730234615865843651857942052864"));
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <ArithLogic.h>
+#include <MainSolver.h>
+
+#include "TestInstances.h"
+
+class RephasingTest : public ::testing::Test {
+protected:
+    RephasingTest() : logic(opensmt::Logic_t::QF_LRA) {
+        const char* msg;
+        config.setOption(SMTConfig::o_sat_rephase_interval, SMTOption(10), msg);
+    }
+    SMTConfig config;
+    ArithLogic logic;
+};
+
+TEST_F(RephasingTest, test_Unsatisfiable) {
+    MainSolver solver(logic, config, "rephasing");
+    solver.insertFormula(pigeonhole(logic, 8, 7));
+    EXPECT_EQ(solver.check(), s_False);
+    EXPECT_GT(solver.getSMTSolver().rephases, 0u);
+}
+
+TEST_F(RephasingTest, test_Satisfiable) {
+    // The pigeons fit when one of them may stay out, but the solver needs conflicts to find out how
+    MainSolver solver(logic, config, "rephasing");
+    PTRef formula = pigeonhole(logic, 9, 8);
+    PTRef outside = logic.mkBoolVar("outside");
+    solver.insertFormula(logic.mkOr(outside, formula));
+    solver.insertFormula(logic.mkOr(logic.mkNot(outside), pigeonhole(logic, 8, 8)));
+    solver.insertFormula(outside);
+    ASSERT_EQ(solver.check(), s_True);
+    EXPECT_EQ(solver.getModel()->evaluate(pigeonhole(logic, 8, 8)), logic.getTerm_true());
+    EXPECT_GT(solver.getSMTSolver().rephases, 0u);
+}
+
+TEST_F(RephasingTest, test_TheoryPhase) {
+    auto chain = disjunctionChain(logic, 20);
+    vec<PTRef> & assertions = chain.assertions;
+    assertions.push(logic.mkGeq(chain.vars.front(), logic.getTerm_RealOne()));
+    MainSolver solver(logic, config, "rephasing");
+    // The chain is solved without conflicts, so let an unsatisfiable query run through the cycle of phases first
+    solver.push();
+    solver.insertFormula(pigeonhole(logic, 8, 7));
+    EXPECT_EQ(solver.check(), s_False);
+    solver.pop();
+    EXPECT_GE(solver.getSMTSolver().rephases, 8u); // The length of the cycle
+    for (PTRef assertion : assertions) {
+        solver.insertFormula(assertion);
+    }
+    ASSERT_EQ(solver.check(), s_True);
+    auto model = solver.getModel();
+    for (PTRef assertion : assertions) {
+        EXPECT_EQ(model->evaluate(assertion), logic.getTerm_true());
+    }
+}
+
+TEST(RephasingConfigTest, test_DisabledByDefault) {
+    SMTConfig config;
+    EXPECT_EQ(config.sat_rephase_interval(), 0);
+    ArithLogic logic(opensmt::Logic_t::QF_LRA);
+    MainSolver solver(logic, config, "rephasing");
+    solver.insertFormula(pigeonhole(logic, 8, 7));
+    EXPECT_EQ(solver.check(), s_False);
+    EXPECT_GT(solver.getSMTSolver().conflicts, 10u);
+    EXPECT_EQ(solver.getSMTSolver().rephases, 0u);
+}
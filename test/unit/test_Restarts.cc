@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <ArithLogic.h>
+#include <MainSolver.h>
+
+#include "TestInstances.h"
+
+TEST(ExponentialMovingAverageTest, test_InitialValuesAreNotBiased) {
+    ExponentialMovingAverage average(1.0 / 32);
+    average.update(10);
+    EXPECT_DOUBLE_EQ(average.value(), 10);
+    average.update(10);
+    EXPECT_DOUBLE_EQ(average.value(), 10);
+    for (int i = 0; i < 10000; i++) {
+        average.update(2);
+    }
+    EXPECT_NEAR(average.value(), 2, 1e-6);
+}
+
+class RestartStrategyTest : public ::testing::Test {
+protected:
+    RestartStrategyTest() : logic(opensmt::Logic_t::QF_LRA) {}
+    SMTConfig config;
+    ArithLogic logic;
+
+    void setStrategy(const char* strategy) {
+        const char* msg;
+        ASSERT_TRUE(config.setOption(SMTConfig::o_sat_restart_strategy, SMTOption(strategy), msg));
+    }
+};
+
+TEST_F(RestartStrategyTest, test_Dynamic) {
+    setStrategy(rstrats_dynamic);
+    MainSolver solver(logic, config, "restarts");
+    solver.insertFormula(pigeonhole(logic, 8, 7));
+    EXPECT_EQ(solver.check(), s_False);
+    EXPECT_GT(solver.getSMTSolver().dynamic_restarts, 0u);
+    EXPECT_EQ(solver.getSMTSolver().restart_phases, 0u);
+}
+
+TEST_F(RestartStrategyTest, test_Alternating) {
+    setStrategy(rstrats_alternating);
+    MainSolver solver(logic, config, "restarts");
+    solver.insertFormula(pigeonhole(logic, 8, 7));
+    EXPECT_EQ(solver.check(), s_False);
+    EXPECT_GT(solver.getSMTSolver().restart_phases, 0u);
+    EXPECT_GT(solver.getSMTSolver().dynamic_restarts, 0u);
+}
+
+TEST_F(RestartStrategyTest, test_UnknownStrategy) {
+    const char* msg = nullptr;
+    EXPECT_FALSE(config.setOption(SMTConfig::o_sat_restart_strategy, SMTOption("never"), msg));
+    EXPECT_EQ(config.sat_restart_strategy(), RestartStrategy::schedule);
+}
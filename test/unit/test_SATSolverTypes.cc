@@ -24,4 +24,22 @@ TEST_F(SATSolverTypesTest, test_ClauseIterator) {
         ASSERT_EQ(l, v[i]);
         i++;
     }
-}
\ No newline at end of file
+}
+TEST_F(SATSolverTypesTest, test_UsedFlag) {
+    vec<Lit> v{mkLit(0), mkLit(1, true), mkLit(2)};
+    CRef original = ca.alloc(v);
+    CRef learnt = ca.alloc(v, {true, 3});
+    EXPECT_FALSE(ca[original].used());
+    EXPECT_TRUE(ca[learnt].used());
+    EXPECT_EQ(ca[learnt].getGlue(), 3);
+    ca[learnt].setUsed(false);
+    ASSERT_EQ(ca[learnt].size(), 3);
+
+    // The flag survives garbage collection
+    ClauseAllocator to;
+    CRef moved = learnt;
+    ca.reloc(moved, to);
+    EXPECT_FALSE(to[moved].used());
+    EXPECT_EQ(to[moved].getGlue(), 3);
+    EXPECT_EQ(to[moved].size(), 3);
+}
@@ -7,6 +7,7 @@
 #include <SMTConfig.h>
 #include <lasolver/LABounds.h>
 #include <lasolver/LAVar.h>
+#include <lasolver/FloatSimplex.h>
 
 TEST(Simplex_test, test_ops_in_Simplex)
 {
@@ -157,3 +158,162 @@ TEST(Simplex_test, test_Assignment)
     EXPECT_GE(x_val, -5);
     EXPECT_EQ(x_val, -1 * y_val);
 }
+
+static void checkSeveralViolatedRows(bool floatingPointGuide)
+{
+    LAVarStore vs;
+
+    LVRef x = vs.getNewVar();
+    LVRef y = vs.getNewVar();
+    LVRef x_plus_y = vs.getNewVar();
+    LVRef x_minus_y = vs.getNewVar();
+    LVRef two_x_plus_y = vs.getNewVar();
+
+    LABoundStore bs(vs);
+
+    LABoundStore::BoundInfo x_plus_y_strict_4 = bs.allocBoundPair(x_plus_y, { Delta(4, -1), Delta(4) }); // x + y < 4 and x + y >= 4
+    LABoundStore::BoundInfo x_minus_y_strict_2 = bs.allocBoundPair(x_minus_y, { Delta(2, -1), Delta(2) }); // x - y < 2 and x - y >= 2
+    LABoundStore::BoundInfo two_x_plus_y_nostrict_10 = bs.allocBoundPair(two_x_plus_y, { Delta(10), Delta(10, 1) }); // 2x + y <= 10 and 2x + y > 10
+    LABoundStore::BoundInfo two_x_plus_y_nostrict_6 = bs.allocBoundPair(two_x_plus_y, { Delta(6), Delta(6, 1) }); // 2x + y <= 6 and 2x + y > 6
+
+    bs.buildBounds();
+
+    Simplex s(bs);
+    s.setFloatingPointGuide(floatingPointGuide);
+
+    s.newNonbasicVar(x);
+    s.newNonbasicVar(y);
+    auto addRow = [&](LVRef row, int xCoeff, int yCoeff) {
+        auto poly = std::make_unique<PolynomialT<LVRef>>();
+        poly->addTerm(x, xCoeff);
+        poly->addTerm(y, yCoeff);
+        s.newRow(row, std::move(poly));
+    };
+    addRow(x_plus_y, 1, 1);
+    addRow(x_minus_y, 1, -1);
+    addRow(two_x_plus_y, 2, 1);
+
+    s.initModel();
+    s.assertBoundOnVar(x_plus_y, x_plus_y_strict_4.lb);
+    s.assertBoundOnVar(x_minus_y, x_minus_y_strict_2.lb);
+    s.assertBoundOnVar(two_x_plus_y, two_x_plus_y_nostrict_10.ub);
+
+    Simplex::Explanation ex = s.checkSimplex();
+    ASSERT_EQ(ex.size(), 0);
+    EXPECT_GE(s.getValuation(x_plus_y), Delta(4));
+    EXPECT_GE(s.getValuation(x_minus_y), Delta(2));
+    EXPECT_LE(s.getValuation(two_x_plus_y), Delta(10));
+    EXPECT_EQ(s.getValuation(two_x_plus_y), 2 * s.getValuation(x) + s.getValuation(y));
+
+    // 2x + y = 3/2 (x + y) + 1/2 (x - y) >= 7
+    s.pushBacktrackPoint();
+    s.assertBoundOnVar(two_x_plus_y, two_x_plus_y_nostrict_6.ub);
+    ex = s.checkSimplex();
+    EXPECT_EQ(ex.size(), 3);
+    s.popBacktrackPoint();
+    s.finalizeBacktracking();
+
+    ex = s.checkSimplex();
+    EXPECT_EQ(ex.size(), 0);
+}
+
+TEST(Simplex_test, test_SeveralViolatedRows)
+{
+    checkSeveralViolatedRows(false);
+}
+
+TEST(Simplex_test, test_SeveralViolatedRowsWithFloatingPointGuide)
+{
+    checkSeveralViolatedRows(true);
+}
+
+static LABoundRef conflictBoundOn(LVRef var, Simplex::Explanation const & explanation, LABoundStore const & bs)
+{
+    for (auto const & term : explanation) {
+        if (bs[term.boundref].getLVRef() == var) { return term.boundref; }
+    }
+    return LABoundRef_Undef;
+}
+
+TEST(Simplex_test, test_ConflictRelaxation)
+{
+    LAVarStore vs;
+
+    LVRef x = vs.getNewVar();
+    LVRef y = vs.getNewVar();
+    LVRef x_plus_y = vs.getNewVar();
+
+    LABoundStore bs(vs);
+
+    LABoundStore::BoundInfo x_strict_5_2 = bs.allocBoundPair(x, { Delta(Real(5, 2), -1), Delta(Real(5, 2)) }); // x < 5/2 and x >= 5/2
+    LABoundStore::BoundInfo x_strict_3 = bs.allocBoundPair(x, { Delta(3, -1), Delta(3) }); // x < 3 and x >= 3
+    LABoundStore::BoundInfo y_strict_0 = bs.allocBoundPair(y, { Delta(0, -1), Delta(0) }); // y < 0 and y >= 0
+    LABoundStore::BoundInfo x_plus_y_nostrict_2 = bs.allocBoundPair(x_plus_y, { Delta(2), Delta(2, 1) }); // x + y <= 2 and x + y > 2
+
+    bs.buildBounds();
+
+    for (std::size_t limit : {0, 8}) {
+        Simplex s(bs);
+        s.setConflictRelaxationLimit(limit);
+        s.newNonbasicVar(x);
+        s.newNonbasicVar(y);
+        auto poly = std::make_unique<PolynomialT<LVRef>>();
+        poly->addTerm(x, 1);
+        poly->addTerm(y, 1);
+        s.newRow(x_plus_y, std::move(poly));
+        s.initModel();
+
+        s.assertBoundOnVar(x, x_strict_5_2.lb);
+        ASSERT_EQ(s.checkSimplex().size(), 0);
+        s.pushBacktrackPoint();
+        s.assertBoundOnVar(x, x_strict_3.lb);
+        ASSERT_EQ(s.checkSimplex().size(), 0);
+        s.pushBacktrackPoint();
+        s.assertBoundOnVar(y, y_strict_0.lb);
+        s.assertBoundOnVar(x_plus_y, x_plus_y_nostrict_2.ub);
+        // x + y <= 2 and y >= 0 contradict x >= 3, and also the weaker x >= 5/2
+        Simplex::Explanation ex = s.checkSimplex();
+        ASSERT_EQ(ex.size(), 3);
+        EXPECT_EQ(conflictBoundOn(x, ex, bs), limit == 0 ? x_strict_3.lb : x_strict_5_2.lb);
+        EXPECT_EQ(conflictBoundOn(y, ex, bs), y_strict_0.lb);
+        EXPECT_EQ(conflictBoundOn(x_plus_y, ex, bs), x_plus_y_nostrict_2.ub);
+    }
+}
+
+TEST(FloatSimplex_test, test_FeasibleBasis)
+{
+    // s = x + y >= 4, t = x - y >= 2, u = 2x + y <= 10, all variables starting at zero
+    FloatSimplex fs;
+    for (unsigned var = 0; var < 5; ++var) {
+        fs.addVar(var, 0);
+    }
+    fs.setLowerBound(2, 4);
+    fs.setLowerBound(3, 2);
+    fs.setUpperBound(4, 10);
+    fs.addRow(2, {{0, 1}, {1, 1}});
+    fs.addRow(3, {{0, 1}, {1, -1}});
+    fs.addRow(4, {{0, 2}, {1, 1}});
+    ASSERT_TRUE(fs.run(100));
+    EXPECT_GT(fs.getNumOfPivots(), 0u);
+    double x = fs.getValue(0);
+    double y = fs.getValue(1);
+    EXPECT_TRUE(x + y >= 4 or fs.isCloseTo(x + y, 4));
+    EXPECT_TRUE(x - y >= 2 or fs.isCloseTo(x - y, 2));
+    EXPECT_TRUE(2 * x + y <= 10 or fs.isCloseTo(2 * x + y, 10));
+    EXPECT_TRUE(fs.isCloseTo(fs.getValue(2), x + y));
+    EXPECT_TRUE(fs.isCloseTo(fs.getValue(4), 2 * x + y));
+}
+
+TEST(FloatSimplex_test, test_Infeasible)
+{
+    // s = x + y >= 4 and u = 2x + 2y <= 6 with x, y starting at zero
+    FloatSimplex fs;
+    for (unsigned var = 0; var < 4; ++var) {
+        fs.addVar(var, 0);
+    }
+    fs.setLowerBound(2, 4);
+    fs.setUpperBound(3, 6);
+    fs.addRow(2, {{0, 1}, {1, 1}});
+    fs.addRow(3, {{0, 2}, {1, 2}});
+    EXPECT_FALSE(fs.run(100));
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <ArithLogic.h>
+#include <MainSolver.h>
+
+class TheoryCombinationTest : public ::testing::Test {
+protected:
+    TheoryCombinationTest() : logic(opensmt::Logic_t::QF_UFLIA) {}
+    ArithLogic logic;
+    SMTConfig config;
+};
+
+TEST_F(TheoryCombinationTest, test_EqualitiesByTransitivity) {
+    // x0 <= x1 <= ... <= x5 <= x0 makes the arguments equal, but only a chain of interface equalities is proposed
+    SymRef f = logic.declareFun("f", logic.getSort_int(), {logic.getSort_int()});
+    int const n = 6;
+    vec<PTRef> xs;
+    for (int i = 0; i < n; ++i) {
+        xs.push(logic.mkIntVar(("x" + std::to_string(i)).c_str()));
+    }
+    vec<PTRef> constraints;
+    for (int i = 0; i < n; ++i) {
+        constraints.push(logic.mkLeq(xs[i], xs[(i + 1) % n]));
+    }
+    MainSolver solver(logic, config, "combination");
+    solver.insertFormula(logic.mkAnd(constraints));
+    solver.insertFormula(logic.mkNot(logic.mkEq(logic.mkUninterpFun(f, {xs[0]}), logic.mkUninterpFun(f, {xs[n - 1]}))));
+    EXPECT_EQ(solver.check(), s_False);
+}
+
+TEST_F(TheoryCombinationTest, test_ModelAgreesOnInterfaceVariables) {
+    // Many interface variables with few values: the model must respect the congruence of f on the equal ones
+    SymRef f = logic.declareFun("f", logic.getSort_int(), {logic.getSort_int()});
+    int const n = 12;
+    vec<PTRef> xs;
+    vec<PTRef> constraints;
+    for (int i = 0; i < n; ++i) {
+        xs.push(logic.mkIntVar(("x" + std::to_string(i)).c_str()));
+        constraints.push(logic.mkGeq(xs.last(), logic.mkIntConst(0)));
+        constraints.push(logic.mkLeq(xs.last(), logic.mkIntConst(2)));
+    }
+    for (int i = 0; i + 1 < n; ++i) {
+        constraints.push(logic.mkLeq(logic.mkUninterpFun(f, {xs[i]}), logic.mkUninterpFun(f, {xs[i + 1]})));
+    }
+    constraints.push(logic.mkNot(logic.mkEq(logic.mkUninterpFun(f, {xs[0]}), logic.mkUninterpFun(f, {xs[n - 1]}))));
+    PTRef formula = logic.mkAnd(constraints);
+    MainSolver solver(logic, config, "combination");
+    solver.insertFormula(formula);
+    ASSERT_EQ(solver.check(), s_True);
+    EXPECT_EQ(solver.getModel()->evaluate(formula), logic.getTerm_true());
+}
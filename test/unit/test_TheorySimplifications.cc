@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 #include <Logic.h>
+#include <ArithLogic.h>
 #include <Substitutor.h>
 
 class GetFactsTest : public ::testing::Test {
@@ -200,3 +201,53 @@ TEST(SubstitutionTransitiveClosure, test_twoStepSubstitution) {
     ASSERT_EQ(substitutions[a], d);
 }
 
+
+//========================== TEST for elimination of arithmetic equalities ===========================================================
+TEST(ArithmeticEliminationTest, test_DefinitionsUseOnlyRemainingVariables) {
+    ArithLogic logic{opensmt::Logic_t::QF_LRA};
+    PTRef a = logic.mkRealVar("a");
+    PTRef b = logic.mkRealVar("b");
+    PTRef c = logic.mkRealVar("c");
+    PTRef d = logic.mkRealVar("d");
+    vec<PtAsgn> facts;
+    facts.push(PtAsgn{logic.mkEq(logic.mkPlus(a, b), c), l_True});
+    facts.push(PtAsgn{logic.mkEq(logic.mkPlus(a, c), d), l_True});
+    facts.push(PtAsgn{logic.mkEq(logic.mkMinus(a, d), b), l_True});
+    auto [res, substitutions] = logic.retrieveSubstitutions(facts);
+    ASSERT_EQ(res, l_Undef);
+    ASSERT_EQ(substitutions.getSize(), 3);
+    for (PTRef var : substitutions.getKeys()) {
+        for (PTRef other : substitutions.getKeys()) {
+            EXPECT_FALSE(logic.contains(substitutions[var], other));
+        }
+    }
+}
+
+TEST(ArithmeticEliminationTest, test_IntegerVariablesWithUnitCoefficients) {
+    ArithLogic logic{opensmt::Logic_t::QF_LIA};
+    PTRef x = logic.mkIntVar("x");
+    PTRef y = logic.mkIntVar("y");
+    PTRef z = logic.mkIntVar("z");
+    vec<PtAsgn> facts;
+    // 3x + 2y = 5 has no unit coefficient; z = x + 2y
+    facts.push(PtAsgn{logic.mkEq(logic.mkPlus(logic.mkTimes(x, logic.mkIntConst(3)), logic.mkTimes(y, logic.mkIntConst(2))), logic.mkIntConst(5)), l_True});
+    facts.push(PtAsgn{logic.mkEq(logic.mkPlus(x, logic.mkTimes(y, logic.mkIntConst(2))), z), l_True});
+    auto [res, substitutions] = logic.retrieveSubstitutions(facts);
+    ASSERT_EQ(res, l_Undef);
+    ASSERT_EQ(substitutions.getSize(), 1);
+    ASSERT_TRUE(substitutions.has(z));
+    EXPECT_EQ(substitutions[z], logic.mkPlus(x, logic.mkTimes(y, logic.mkIntConst(2))));
+}
+
+TEST(ArithmeticEliminationTest, test_IntegerInconsistency) {
+    ArithLogic logic{opensmt::Logic_t::QF_LIA};
+    PTRef x = logic.mkIntVar("x");
+    PTRef y = logic.mkIntVar("y");
+    PTRef z = logic.mkIntVar("z");
+    vec<PtAsgn> facts;
+    // 2x + 4y = z and z = 5 have no integer solution
+    facts.push(PtAsgn{logic.mkEq(logic.mkPlus(logic.mkTimes(x, logic.mkIntConst(2)), logic.mkTimes(y, logic.mkIntConst(4))), z), l_True});
+    facts.push(PtAsgn{logic.mkEq(z, logic.mkIntConst(5)), l_True});
+    auto [res, substitutions] = logic.retrieveSubstitutions(facts);
+    EXPECT_EQ(res, l_False);
+}